@@ -0,0 +1,355 @@
+#ifndef FASTBC_CSR_GRAPH_H
+#define FASTBC_CSR_GRAPH_H
+
+#include <IDegreeGraph.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace fastbc {
+
+	/**
+	 *	@brief Immutable directed weighted graph in compressed sparse row format
+	 *
+	 *	@details Forward and backward stars are stored as an offsets array plus
+	 *			 contiguous neighbor and weight arrays, one copy per direction.
+	 *			 Neighbors of each vertex are sorted by index. Arrays can either be
+	 *			 owned by the graph or live in external memory kept alive by a
+	 *			 storage handle (e.g. a memory mapped file).
+	 *
+	 *	@tparam V Type for vertex index number
+	 *	@tparam W Type for edge weight value
+	 */
+	template<typename V, typename W>
+	class CSRGraph : public IDegreeGraph<V, W>
+	{
+	public:
+		typedef std::uint64_t offset_t;
+
+		/**
+		 *	@brief Initialize a compact copy of given graph
+		 *
+		 *	@param graph Complete graph to copy (vertex indices from 0 to graph.vertices().size())
+		 */
+		CSRGraph(const IGraph<V, W>& graph);
+
+		/**
+		 *	@brief Initialize a graph taking ownership of given CSR arrays
+		 *
+		 *	@details Offsets arrays must have #vertices + 1 elements, the first being 0.
+		 *			 Neighbors of each vertex must be sorted by index.
+		 */
+		CSRGraph(
+			std::vector<offset_t>&& outOffsets,
+			std::vector<V>&& outTargets,
+			std::vector<W>&& outWeights,
+			std::vector<offset_t>&& inOffsets,
+			std::vector<V>&& inSources,
+			std::vector<W>&& inWeights);
+
+		/**
+		 *	@brief Initialize a graph referencing external CSR arrays without copying them
+		 *
+		 *	@param vertexCount Number of graph vertices
+		 *	@param totalWeight Sum of all edge weights
+		 *	@param outOffsets Forward star offsets (vertexCount + 1 elements)
+		 *	@param outTargets Forward star neighbors
+		 *	@param outWeights Forward star weights
+		 *	@param inOffsets Backward star offsets (vertexCount + 1 elements)
+		 *	@param inSources Backward star neighbors
+		 *	@param inWeights Backward star weights
+		 *	@param storage Handle keeping referenced memory alive for graph lifetime
+		 */
+		CSRGraph(
+			V vertexCount,
+			W totalWeight,
+			const offset_t* outOffsets,
+			const V* outTargets,
+			const W* outWeights,
+			const offset_t* inOffsets,
+			const V* inSources,
+			const W* inWeights,
+			std::shared_ptr<const void> storage);
+
+		W edge(V src, V dest) const override;
+
+		EdgeSpan<V, W> forwardStar(V src) const override;
+
+		EdgeSpan<V, W> backwardStar(V dest) const override;
+
+		const std::vector<V>& vertices() const override;
+
+		V edges() const override;
+
+		W totalWeight() const override;
+
+		W inWeightedDegree(V v) const override;
+
+		W outWeightedDegree(V v) const override;
+
+		/**
+		 *	@brief Check if all graph edges share the same weight
+		 *
+		 *	@details Weights are scanned on each call, in O(#edges) time.
+		 *			 A graph without edges is considered uniform.
+		 */
+		bool uniformWeights() const;
+
+		/**
+		 *	@brief Raw CSR arrays accessors
+		 */
+		const offset_t* outOffsets() const { return _outOffsets; }
+		const V* outTargets() const { return _outTargets; }
+		const W* outWeights() const { return _outWeights; }
+		const offset_t* inOffsets() const { return _inOffsets; }
+		const V* inSources() const { return _inSources; }
+		const W* inWeights() const { return _inWeights; }
+
+	private:
+
+		struct owned_storage_t
+		{
+			std::vector<offset_t> outOffsets;
+			std::vector<V> outTargets;
+			std::vector<W> outWeights;
+			std::vector<offset_t> inOffsets;
+			std::vector<V> inSources;
+			std::vector<W> inWeights;
+		};
+
+		void _init(std::shared_ptr<owned_storage_t> storage);
+
+		std::vector<V> _vertices;
+		W _totalWeight;
+		const offset_t* _outOffsets;
+		const V* _outTargets;
+		const W* _outWeights;
+		const offset_t* _inOffsets;
+		const V* _inSources;
+		const W* _inWeights;
+		std::shared_ptr<const void> _storage;
+	};
+
+}
+
+template<typename V, typename W>
+fastbc::CSRGraph<V, W>::CSRGraph(const IGraph<V, W>& graph)
+{
+	auto storage = std::make_shared<owned_storage_t>();
+	size_t vertexCount = graph.vertices().size();
+
+	// Compute offsets of each vertex star
+	storage->outOffsets.resize(vertexCount + 1, 0);
+	storage->inOffsets.resize(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		storage->outOffsets[v + 1] = storage->outOffsets[v] + graph.forwardStar(v).size();
+		storage->inOffsets[v + 1] = storage->inOffsets[v] + graph.backwardStar(v).size();
+	}
+
+	storage->outTargets.resize(storage->outOffsets[vertexCount]);
+	storage->outWeights.resize(storage->outOffsets[vertexCount]);
+	storage->inSources.resize(storage->inOffsets[vertexCount]);
+	storage->inWeights.resize(storage->inOffsets[vertexCount]);
+
+	// Copy stars in their contiguous position
+	#pragma omp parallel for schedule(dynamic, 1024)
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		offset_t out = storage->outOffsets[v];
+		for (const auto& [dest, weight] : graph.forwardStar(v))
+		{
+			storage->outTargets[out] = dest;
+			storage->outWeights[out] = weight;
+			++out;
+		}
+
+		offset_t in = storage->inOffsets[v];
+		for (const auto& [src, weight] : graph.backwardStar(v))
+		{
+			storage->inSources[in] = src;
+			storage->inWeights[in] = weight;
+			++in;
+		}
+	}
+
+	_init(storage);
+}
+
+template<typename V, typename W>
+fastbc::CSRGraph<V, W>::CSRGraph(
+	std::vector<offset_t>&& outOffsets,
+	std::vector<V>&& outTargets,
+	std::vector<W>&& outWeights,
+	std::vector<offset_t>&& inOffsets,
+	std::vector<V>&& inSources,
+	std::vector<W>&& inWeights)
+{
+	if (outOffsets.empty() || outOffsets.size() != inOffsets.size()
+		|| outTargets.size() != outOffsets.back() || outWeights.size() != outTargets.size()
+		|| inSources.size() != inOffsets.back() || inWeights.size() != inSources.size())
+	{
+		throw std::invalid_argument("Inconsistent CSR arrays size");
+	}
+
+	auto storage = std::make_shared<owned_storage_t>();
+	storage->outOffsets = std::move(outOffsets);
+	storage->outTargets = std::move(outTargets);
+	storage->outWeights = std::move(outWeights);
+	storage->inOffsets = std::move(inOffsets);
+	storage->inSources = std::move(inSources);
+	storage->inWeights = std::move(inWeights);
+
+	_init(storage);
+}
+
+template<typename V, typename W>
+fastbc::CSRGraph<V, W>::CSRGraph(
+	V vertexCount,
+	W totalWeight,
+	const offset_t* outOffsets,
+	const V* outTargets,
+	const W* outWeights,
+	const offset_t* inOffsets,
+	const V* inSources,
+	const W* inWeights,
+	std::shared_ptr<const void> storage)
+	: _vertices(vertexCount),
+	_totalWeight(totalWeight),
+	_outOffsets(outOffsets),
+	_outTargets(outTargets),
+	_outWeights(outWeights),
+	_inOffsets(inOffsets),
+	_inSources(inSources),
+	_inWeights(inWeights),
+	_storage(storage)
+{
+	#pragma omp simd
+	for (size_t v = 0; v < _vertices.size(); ++v)
+	{
+		_vertices[v] = v;
+	}
+}
+
+template<typename V, typename W>
+void fastbc::CSRGraph<V, W>::_init(std::shared_ptr<owned_storage_t> storage)
+{
+	_outOffsets = storage->outOffsets.data();
+	_outTargets = storage->outTargets.data();
+	_outWeights = storage->outWeights.data();
+	_inOffsets = storage->inOffsets.data();
+	_inSources = storage->inSources.data();
+	_inWeights = storage->inWeights.data();
+
+	_vertices.resize(storage->outOffsets.size() - 1);
+	#pragma omp simd
+	for (size_t v = 0; v < _vertices.size(); ++v)
+	{
+		_vertices[v] = v;
+	}
+
+	W totalWeight = 0;
+	#pragma omp parallel for reduction(+:totalWeight)
+	for (size_t e = 0; e < storage->outWeights.size(); ++e)
+	{
+		totalWeight += _outWeights[e];
+	}
+	_totalWeight = totalWeight;
+
+	_storage = storage;
+}
+
+template<typename V, typename W>
+W fastbc::CSRGraph<V, W>::edge(V src, V dest) const
+{
+	const auto fs = forwardStar(src);
+
+	if (auto it = fs.find(dest); it != fs.end())
+	{
+		return it->second;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+template<typename V, typename W>
+fastbc::EdgeSpan<V, W> fastbc::CSRGraph<V, W>::forwardStar(V src) const
+{
+	return EdgeSpan<V, W>(_outTargets + _outOffsets[src], _outWeights + _outOffsets[src],
+		_outOffsets[src + 1] - _outOffsets[src]);
+}
+
+template<typename V, typename W>
+fastbc::EdgeSpan<V, W> fastbc::CSRGraph<V, W>::backwardStar(V dest) const
+{
+	return EdgeSpan<V, W>(_inSources + _inOffsets[dest], _inWeights + _inOffsets[dest],
+		_inOffsets[dest + 1] - _inOffsets[dest]);
+}
+
+template<typename V, typename W>
+const std::vector<V>& fastbc::CSRGraph<V, W>::vertices() const
+{
+	return _vertices;
+}
+
+template<typename V, typename W>
+V fastbc::CSRGraph<V, W>::edges() const
+{
+	return _outOffsets[_vertices.size()];
+}
+
+template<typename V, typename W>
+W fastbc::CSRGraph<V, W>::totalWeight() const
+{
+	return _totalWeight;
+}
+
+template<typename V, typename W>
+W fastbc::CSRGraph<V, W>::inWeightedDegree(V v) const
+{
+	W degree = 0;
+	for (offset_t e = _inOffsets[v]; e < _inOffsets[v + 1]; ++e)
+	{
+		degree += _inWeights[e];
+	}
+
+	return degree;
+}
+
+template<typename V, typename W>
+W fastbc::CSRGraph<V, W>::outWeightedDegree(V v) const
+{
+	W degree = 0;
+	for (offset_t e = _outOffsets[v]; e < _outOffsets[v + 1]; ++e)
+	{
+		degree += _outWeights[e];
+	}
+
+	return degree;
+}
+
+template<typename V, typename W>
+bool fastbc::CSRGraph<V, W>::uniformWeights() const
+{
+	offset_t edgeCount = _outOffsets[_vertices.size()];
+	if (edgeCount == 0)
+	{
+		return true;
+	}
+
+	const W first = _outWeights[0];
+	bool uniform = true;
+	#pragma omp parallel for reduction(&&:uniform)
+	for (offset_t e = 1; e < edgeCount; ++e)
+	{
+		uniform = uniform && _outWeights[e] == first;
+	}
+
+	return uniform;
+}
+
+#endif
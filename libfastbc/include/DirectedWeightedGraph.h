@@ -3,9 +3,11 @@
 
 #include <IDegreeGraph.h>
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
-#include <map>
-#include <set>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace fastbc {
@@ -30,17 +32,28 @@ namespace fastbc {
 
         W edge(V src, V dest) const override;
 
-        const std::map<V, W>& forwardStar(V src) const override;
+        EdgeSpan<V, W> forwardStar(V src) const override;
 
-		const std::map<V, W>& backwardStar(V dest) const override;
+		EdgeSpan<V, W> backwardStar(V dest) const override;
 
 		const std::vector<V>& vertices() const override;
 
         V edges() const override;
 
-        void addEdge(V from, V to, W weight) override;
+		/**
+		 *	@brief Add given edge to the graph, summing its weight when already present
+		 *
+		 *	@details Edges are appended to vertex stars in O(1), stars are sorted and
+		 *			 duplicated edges merged by initVertices
+		 */
+        void addEdge(V from, V to, W weight);
 
-        void initVertices() override;
+		/**
+		 *	@brief Sort vertex stars and initialize vertices list after edges insertion
+		 *
+		 *	@note Must be called before querying the graph
+		 */
+        void initVertices();
 
         W totalWeight() const override;
 
@@ -49,24 +62,37 @@ namespace fastbc {
         W outWeightedDegree(V v) const override;
         
     private:
+
+		/**
+		 *	@brief Vertex star stored as parallel neighbor/weight arrays sorted by neighbor
+		 */
+		struct star_t
+		{
+			std::vector<V> vertices;
+			std::vector<W> weights;
+
+			// Sort by neighbor and sum weights of duplicated edges, return star size
+			size_t merge();
+		};
+
         V _edges;
         W _totalWeight;
 		std::vector<V> _vertices;
 		std::vector<W> _inWeightedDegrees;
 		std::vector<W> _outWeightedDegrees;
-        std::vector<std::map<V, W>> _srcDestWeight;
-		std::vector<std::map<V, W>> _destSrcWeight;
+        std::vector<star_t> _srcDestWeight;
+		std::vector<star_t> _destSrcWeight;
     };   
 
 }
 
 template<typename V, typename W>
 fastbc::DirectedWeightedGraph<V, W>::DirectedWeightedGraph()
-	: _edges(0) {}
+	: _edges(0), _totalWeight(0) {}
 
 template<typename V, typename W>
 fastbc::DirectedWeightedGraph<V, W>::DirectedWeightedGraph(std::istream& inputTextGraph)
-    : _edges(0)
+    : _edges(0), _totalWeight(0)
 {
 	// Read input stream and initialize forward and backward star for each vertex
     while (!inputTextGraph.eof())
@@ -89,16 +115,54 @@ fastbc::DirectedWeightedGraph<V, W>::DirectedWeightedGraph(std::istream& inputTe
         addEdge(src, dest, weight);
     }
 
-	// Ensure both forward and backward star containers share same size
-	_destSrcWeight.resize(_srcDestWeight.size());
-
 	initVertices();
 }
 
+template<typename V, typename W>
+size_t fastbc::DirectedWeightedGraph<V, W>::star_t::merge()
+{
+	if (std::is_sorted(vertices.begin(), vertices.end(), std::less_equal<V>()))
+	{
+		return vertices.size();
+	}
+
+	// Stable sort keeps insertion order of duplicated edges weights
+	std::vector<std::pair<V, W>> edges(vertices.size());
+	for (size_t i = 0; i < edges.size(); ++i)
+	{
+		edges[i] = std::make_pair(vertices[i], weights[i]);
+	}
+	std::stable_sort(edges.begin(), edges.end(),
+		[](const std::pair<V, W>& a, const std::pair<V, W>& b) { return a.first < b.first; });
+
+	size_t last = 0;
+	vertices[0] = edges[0].first;
+	weights[0] = edges[0].second;
+	for (size_t i = 1; i < edges.size(); ++i)
+	{
+		if (edges[i].first == vertices[last])
+		{
+			weights[last] += edges[i].second;
+		}
+		else
+		{
+			++last;
+			vertices[last] = edges[i].first;
+			weights[last] = edges[i].second;
+		}
+	}
+
+	vertices.resize(last + 1);
+	weights.resize(last + 1);
+	return vertices.size();
+}
+
 template<typename V, typename W>
 W fastbc::DirectedWeightedGraph<V, W>::edge(V src, V dest) const
 {
-    if(auto it = _srcDestWeight[src].find(dest); it != _srcDestWeight[src].end())
+	const auto fs = forwardStar(src);
+
+    if(auto it = fs.find(dest); it != fs.end())
     {
         return it->second;
     }
@@ -109,15 +173,17 @@ W fastbc::DirectedWeightedGraph<V, W>::edge(V src, V dest) const
 }
 
 template<typename V, typename W>
-const std::map<V, W>& fastbc::DirectedWeightedGraph<V, W>::forwardStar(V src) const
+fastbc::EdgeSpan<V, W> fastbc::DirectedWeightedGraph<V, W>::forwardStar(V src) const
 {
-    return _srcDestWeight[src];
+	const star_t& star = _srcDestWeight[src];
+    return EdgeSpan<V, W>(star.vertices.data(), star.weights.data(), star.vertices.size());
 }
 
 template<typename V, typename W>
-const std::map<V, W>& fastbc::DirectedWeightedGraph<V, W>::backwardStar(V dest) const
+fastbc::EdgeSpan<V, W> fastbc::DirectedWeightedGraph<V, W>::backwardStar(V dest) const
 {
-	return _destSrcWeight[dest];
+	const star_t& star = _destSrcWeight[dest];
+	return EdgeSpan<V, W>(star.vertices.data(), star.weights.data(), star.vertices.size());
 }
 
 template<typename V, typename W>
@@ -135,34 +201,20 @@ V fastbc::DirectedWeightedGraph<V, W>::edges() const
 template<typename V, typename W>
 void fastbc::DirectedWeightedGraph<V, W>::addEdge(V from, V to, W weight) 
 {
-	if(_srcDestWeight.size() <= from)
-    {
-        _srcDestWeight.resize(from + 1);
-    }
-
-	if (_destSrcWeight.size() <= to)
+	// Both forward and backward star containers share same size
+	size_t s = (size_t)((to > from) ? to : from) + 1;
+	if (_srcDestWeight.size() < s)
 	{
-		_destSrcWeight.resize(to + 1);
-	}
-
-	int s = (to > from) ? to : from;
-	if (_inWeightedDegrees.size() <= s)
-		_inWeightedDegrees.resize(s + 1, 0);
-	if (_outWeightedDegrees.size() <= s)
-		_outWeightedDegrees.resize(s + 1, 0);
-
-	if(_srcDestWeight[from].count(to) > 0) {
-		_srcDestWeight[from][to] += weight;
-	} else {
-		_srcDestWeight[from][to] = weight;
-    	_edges++;
+		_srcDestWeight.resize(s);
+		_destSrcWeight.resize(s);
+		_inWeightedDegrees.resize(s, 0);
+		_outWeightedDegrees.resize(s, 0);
 	}
 
-	if(_destSrcWeight[to].count(from) > 0) {
-		_destSrcWeight[to][from] += weight;
-	} else {
-		_destSrcWeight[to][from] = weight;
-	}
+	_srcDestWeight[from].vertices.push_back(to);
+	_srcDestWeight[from].weights.push_back(weight);
+	_destSrcWeight[to].vertices.push_back(from);
+	_destSrcWeight[to].weights.push_back(weight);
 
     _totalWeight += weight;
 	_inWeightedDegrees[to] += weight;
@@ -172,6 +224,16 @@ void fastbc::DirectedWeightedGraph<V, W>::addEdge(V from, V to, W weight)
 template<typename V, typename W>
 void fastbc::DirectedWeightedGraph<V, W>::initVertices() 
 {
+	// Sort stars and merge duplicated edges
+	V edges = 0;
+	#pragma omp parallel for schedule(dynamic, 1024) reduction(+:edges)
+	for (size_t v = 0; v < _srcDestWeight.size(); v++)
+	{
+		edges += _srcDestWeight[v].merge();
+		_destSrcWeight[v].merge();
+	}
+	_edges = edges;
+
 	// Initialize vertices list
 	_vertices.resize(_srcDestWeight.size());
 	#pragma omp simd
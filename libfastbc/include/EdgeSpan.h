@@ -0,0 +1,201 @@
+#ifndef FASTBC_EDGE_SPAN_H
+#define FASTBC_EDGE_SPAN_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace fastbc {
+
+	/**
+	 *	@brief Non-owning view over the star of a vertex
+	 *
+	 *	@details Neighbor indices and edge weights are stored in two contiguous arrays
+	 *			 of the same size, ordered by increasing neighbor index. Iterating over
+	 *			 the span yields (neighbor, weight) pairs by value.
+	 *			 A span can be restricted to the neighbors labelled with a given
+	 *			 cluster: filtered out edges are skipped by iteration, size() and
+	 *			 find(), so a sub-graph star is a view over its reference graph.
+	 *			 Raw arrays are only exposed by spans which are not filtered.
+	 *
+	 *	@tparam V Type for vertex index number
+	 *	@tparam W Type for edge weight value
+	 */
+	template<typename V, typename W>
+	class EdgeSpan
+	{
+	public:
+
+		class iterator
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef std::pair<V, W> value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef std::pair<V, W> reference;
+
+			struct pointer
+			{
+				std::pair<V, W> edge;
+				const std::pair<V, W>* operator->() const { return &edge; }
+			};
+
+			iterator() : _vertex(nullptr), _weight(nullptr), _end(nullptr), _label(nullptr), _cluster() {}
+			iterator(const V* vertex, const W* weight) 
+				: _vertex(vertex), _weight(weight), _end(vertex), _label(nullptr), _cluster() {}
+			iterator(const V* vertex, const W* weight, const V* end, const V* label, V cluster)
+				: _vertex(vertex), _weight(weight), _end(end), _label(label), _cluster(cluster) { _skip(); }
+
+			reference operator*() const { return std::make_pair(*_vertex, *_weight); }
+			pointer operator->() const { return pointer{ **this }; }
+
+			iterator& operator++() 
+			{ 
+				++_vertex; 
+				++_weight; 
+				if (_label != nullptr)
+				{
+					_skip();
+				}
+				return *this; 
+			}
+			iterator operator++(int) { iterator it(*this); ++(*this); return it; }
+
+			bool operator==(const iterator& other) const { return _vertex == other._vertex; }
+			bool operator!=(const iterator& other) const { return _vertex != other._vertex; }
+
+		private:
+
+			// Move to next edge whose neighbor belongs to the filter cluster
+			void _skip()
+			{
+				while (_vertex != _end && _label[*_vertex] != _cluster)
+				{
+					++_vertex;
+					++_weight;
+				}
+			}
+
+			const V* _vertex;
+			const W* _weight;
+			const V* _end;
+			const V* _label;
+			V _cluster;
+		};
+
+		EdgeSpan() : _vertices(nullptr), _weights(nullptr), _size(0), _label(nullptr), _cluster() {}
+
+		/**
+		 *	@brief Initialize a view over size neighbors and related edge weights
+		 *
+		 *	@param vertices First neighbor index, neighbors must be sorted
+		 *	@param weights First edge weight
+		 *	@param size Number of neighbors
+		 */
+		EdgeSpan(const V* vertices, const W* weights, size_t size)
+			: _vertices(vertices), _weights(weights), _size(size), _label(nullptr), _cluster() {}
+
+		/**
+		 *	@brief Initialize a view over the edges of given span reaching a cluster
+		 *
+		 *	@param span Unfiltered star
+		 *	@param label Cluster label of each vertex of the reference graph
+		 *	@param cluster Label of neighbors to keep
+		 */
+		EdgeSpan(const EdgeSpan& span, const V* label, V cluster)
+			: _vertices(span._vertices), _weights(span._weights), _size(span._size), _label(label), _cluster(cluster) {}
+
+		iterator begin() const 
+		{ 
+			if (_label == nullptr)
+			{
+				return iterator(_vertices, _weights);
+			}
+
+			return iterator(_vertices, _weights, _vertices + _size, _label, _cluster);
+		}
+
+		iterator end() const { return iterator(_vertices + _size, _weights + _size); }
+
+		/**
+		 *	@brief Number of edges in the view
+		 *
+		 *	@note Linear in the unfiltered star size when the span is filtered
+		 */
+		size_t size() const 
+		{ 
+			if (_label == nullptr)
+			{
+				return _size;
+			}
+
+			return std::count_if(_vertices, _vertices + _size, 
+				[this](V v) { return _label[v] == _cluster; });
+		}
+
+		bool empty() const { return begin() == end(); }
+
+		/**
+		 *	@brief Check if edges are filtered by cluster label
+		 */
+		bool filtered() const { return _label != nullptr; }
+
+		/**
+		 *	@brief Contiguous neighbor indices array, size() long
+		 *
+		 *	@note Only available on spans which are not filtered, see filtered()
+		 */
+		const V* vertices() const 
+		{ 
+			assert(_label == nullptr && "Raw neighbors of a filtered span include filtered out edges");
+			return _vertices; 
+		}
+
+		/**
+		 *	@brief Contiguous edge weights array, parallel to vertices()
+		 *
+		 *	@note Only available on spans which are not filtered, see filtered()
+		 */
+		const W* weights() const 
+		{ 
+			assert(_label == nullptr && "Raw weights of a filtered span include filtered out edges");
+			return _weights; 
+		}
+
+		/**
+		 *	@brief Find edge to given neighbor with a binary search
+		 *
+		 *	@param vertex Neighbor index
+		 *	@return iterator Iterator to the edge if found, end() else; on a filtered
+		 *			span it skips filtered out edges when incremented
+		 */
+		iterator find(V vertex) const
+		{
+			const V* it = std::lower_bound(_vertices, _vertices + _size, vertex);
+			if (it != _vertices + _size && *it == vertex && 
+				(_label == nullptr || _label[vertex] == _cluster))
+			{
+				if (_label == nullptr)
+				{
+					return iterator(it, _weights + (it - _vertices));
+				}
+
+				return iterator(it, _weights + (it - _vertices), _vertices + _size, _label, _cluster);
+			}
+
+			return end();
+		}
+
+	private:
+		const V* _vertices;
+		const W* _weights;
+		size_t _size;
+		const V* _label;
+		V _cluster;
+	};
+
+}
+
+#endif
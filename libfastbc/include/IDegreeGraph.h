@@ -9,10 +9,6 @@ namespace fastbc {
     {
     public:
 
-        virtual void addEdge(V from, V to, W weight) = 0;
-
-        virtual void initVertices() = 0;
-
         virtual W totalWeight() const = 0;
 
         virtual W inWeightedDegree(V v) const = 0;
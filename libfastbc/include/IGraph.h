@@ -1,7 +1,8 @@
 #ifndef FASTBC_IGRAPH_H
 #define FASTBC_IGRAPH_H
 
-#include <map>
+#include <EdgeSpan.h>
+
 #include <vector>
 
 namespace fastbc {
@@ -34,17 +35,17 @@ namespace fastbc {
          *	@brief Get forward star vertex/weight for given src vertex
          * 
          *	@param src Vertex index 
-         *	@return const std::map<V, W>& Dest/edge weight map of all outgoing edges from src vertex
+         *	@return EdgeSpan<V, W> Dest/edge weight view of all outgoing edges from src vertex
          */
-        virtual const std::map<V, W>& forwardStar(V src) const = 0;
+        virtual EdgeSpan<V, W> forwardStar(V src) const = 0;
 
 		/**
 		 *	@brief Get backward star vertex/weight for given dest vertex
 		 * 
 		 *	@param dest Vertex index
-		 *	@return const std::map<V, W>& Src/edge weight map of all incoming edges to dest vertex
+		 *	@return EdgeSpan<V, W> Src/edge weight view of all incoming edges to dest vertex
 		 */
-		virtual const std::map<V, W>& backwardStar(V dest) const = 0;
+		virtual EdgeSpan<V, W> backwardStar(V dest) const = 0;
 
 		/**
 		 *	@brief Get full list of vertices in this graph
@@ -3,6 +3,9 @@
 
 #include "IDegreeGraph.h"
 
+#include <memory>
+#include <vector>
+
 namespace fastbc {
 
 	template<typename V, typename W>
@@ -4,23 +4,39 @@
 #include "IGraph.h"
 #include "ISubGraph.h"
 
-#include <map>
+#include <limits>
 #include <memory>
 #include <set>
 #include <spdlog/spdlog.h>
+#include <stdexcept>
 #include <vector>
 
 namespace fastbc {
 
+	/**
+	 *	@brief Sub-graph of a reference graph induced by a set of vertices
+	 *
+	 *	@details Vertices are identified by a cluster label array, shared by all the
+	 *			 sub-graphs of a partition. Stars of border vertices are filtered views
+	 *			 over the reference graph ones, no edge is copied.
+	 */
 	template<typename V, typename W>
 	class SubGraph : public ISubGraph<V, W>
 	{
 	public:
+
+		/**
+		 *	@brief Cluster label of vertices outside every sub-graph
+		 */
+		static constexpr V NO_CLUSTER = std::numeric_limits<V>::max();
+
 		/**
 		 *	@brief Initialize a sub-graph with given vertices
 		 * 
-		 *	@details Initialization will search for border vertices in O(m*log(n)) time
-		 *			 where n is number of vertices and m number of edges
+		 *	@details Initialization labels the reference graph vertices, taking O(n) memory,
+		 *			 and searches for border vertices in O(m) time where n is number of
+		 *			 graph vertices and m number of sub-graph vertices edges. 
+		 *			 Prefer fromPartition() to build the sub-graphs of a whole partition.
 		 * 
 		 *	@param subGraphVertices Vertices of sub-graph to consider
 		 *	@param referenceGraph Full graph where the sub-graph is computed
@@ -29,11 +45,25 @@ namespace fastbc {
 			const std::vector<V>& subGraphVertices, 
 			std::shared_ptr<const IGraph<V, W>> referenceGraph);
 
+		/**
+		 *	@brief Build the sub-graph of each community of a partition
+		 *
+		 *	@details Cluster labels are computed once and shared among all sub-graphs, 
+		 *			 border vertices are found by a single parallel pass over the graph.
+		 *
+		 *	@param communities Disjoint sets of vertices, one for each sub-graph
+		 *	@param referenceGraph Full graph where the sub-graphs are computed
+		 *	@return Sub-graph of each community, in communities order
+		 */
+		static std::vector<std::shared_ptr<SubGraph<V, W>>> fromPartition(
+			const std::vector<std::vector<V>>& communities,
+			std::shared_ptr<const IGraph<V, W>> referenceGraph);
+
 		W edge(V src, V dest) const override;
 
-		const std::map<V, W>& forwardStar(V src) const override;
+		EdgeSpan<V, W> forwardStar(V src) const override;
 
-		const std::map<V, W>& backwardStar(V dest) const override;
+		EdgeSpan<V, W> backwardStar(V dest) const override;
 
 		const std::vector<V>& vertices() const override;
 
@@ -46,11 +76,47 @@ namespace fastbc {
 		std::shared_ptr<const IGraph<V, W>> referenceGraph() const override;
 
 	private:
+
+		/**
+		 *	@brief Partition information shared among sub-graphs
+		 */
+		struct membership_t
+		{
+			// Cluster label of each reference graph vertex
+			std::vector<V> label;
+
+			// Border flag of each reference graph vertex
+			std::vector<char> border;
+		};
+
+		/**
+		 *	@brief Sub-graph edges and border state of a vertex
+		 */
+		struct scan_t
+		{
+			V edges = 0;
+			bool border = false;
+			bool unconnected = false;
+		};
+
+		SubGraph(
+			const std::vector<V>& subGraphVertices,
+			std::shared_ptr<const IGraph<V, W>> referenceGraph,
+			std::shared_ptr<const membership_t> membership,
+			V cluster);
+
+		static scan_t _scan(
+			V v,
+			const std::vector<V>& label,
+			const IGraph<V, W>& graph);
+
+		static void _unconnected(V v);
+
 		const std::shared_ptr<const IGraph<V, W>> _referenceGraph;
 		const std::vector<V> _vertices;
+		std::shared_ptr<const membership_t> _membership;
+		V _cluster;
 		V _edges;
-		std::map<V, std::map<V, W>> _borderDestWeight;
-		std::map<V, std::map<V, W>> _borderSrcWeight;
 		std::set<V> _borderVertices;
 	};
 
@@ -62,95 +128,186 @@ fastbc::SubGraph<V, W>::SubGraph(
 	std::shared_ptr<const IGraph<V, W>> referenceGraph)
 	: _referenceGraph(referenceGraph),
 	_vertices(subGraphVertices),
+	_cluster(0),
 	_edges(0)
 {
-	// Order sub-graph vertices to speed-up border vertices computation
-	std::set orderedVertices(_vertices.begin(), _vertices.end());
+	auto membership = std::make_shared<membership_t>();
+	membership->label.resize(_referenceGraph->vertices().size(), NO_CLUSTER);
+	membership->border.resize(_referenceGraph->vertices().size(), 0);
 
-	for (size_t vIndex = 0; vIndex < _vertices.size(); ++vIndex)
+	for (const auto& v : _vertices)
 	{
-		const V& v = _vertices[vIndex];
+		membership->label[v] = _cluster;
+	}
 
-		// Check vertex forward star for edges terminating outside the graph
-		const auto& fs = _referenceGraph->forwardStar(v);
+	for (const auto& v : _vertices)
+	{
+		scan_t scan = _scan(v, membership->label, *_referenceGraph);
 
-		bool isBorder = false;
-		V connections = 0;
-		std::vector<V> outEdges;
+		// Update sub-graph edges counter
+		_edges += scan.edges;
 
-		for (auto& e : fs)
+		if (scan.border)
 		{
-			// When a vertex has an edge outside the sub-graph set it as border and store outgoing edge
-			if (auto dest = orderedVertices.find(e.first); dest == orderedVertices.end())
-			{
-				isBorder = true;
-				outEdges.push_back(e.first);
-			}
+			membership->border[v] = 1;
+			_borderVertices.insert(v);
 		}
 
-		// If vertex has been detected as border store a consistent forward star contained in sub-graph
-		if (isBorder)
+		// If a vertex runs out of edges, the sub-graph is not consistent
+		if (scan.unconnected && _vertices.size() > 1)
 		{
-			// Copy forward star from reference graph removing each unnecessary outgoing edge
-			_borderDestWeight[v] = std::map<V, W>(fs);
-			for (auto& out : outEdges)
-			{
-				_borderDestWeight[v].erase(out);
-			}
-			connections += _borderDestWeight[v].size();
+			_unconnected(v);
+		}
+	}
 
-			_borderVertices.insert(v);
+	_membership = membership;
+}
+
+template<typename V, typename W>
+fastbc::SubGraph<V, W>::SubGraph(
+	const std::vector<V>& subGraphVertices,
+	std::shared_ptr<const IGraph<V, W>> referenceGraph,
+	std::shared_ptr<const membership_t> membership,
+	V cluster)
+	: _referenceGraph(referenceGraph),
+	_vertices(subGraphVertices),
+	_membership(membership),
+	_cluster(cluster),
+	_edges(0)
+{
+}
+
+template<typename V, typename W>
+std::vector<std::shared_ptr<fastbc::SubGraph<V, W>>> fastbc::SubGraph<V, W>::fromPartition(
+	const std::vector<std::vector<V>>& communities,
+	std::shared_ptr<const IGraph<V, W>> referenceGraph)
+{
+	size_t vertexCount = referenceGraph->vertices().size();
+
+	auto membership = std::make_shared<membership_t>();
+	membership->label.resize(vertexCount, NO_CLUSTER);
+	membership->border.resize(vertexCount, 0);
+
+	// Label each vertex with its community
+	#pragma omp parallel for schedule(dynamic, 64)
+	for (size_t c = 0; c < communities.size(); ++c)
+	{
+		for (const auto& v : communities[c])
+		{
+			membership->label[v] = c;
 		}
+	}
 
-		// Update sub-graph edges counter
-		_edges += fs.size() - outEdges.size();
+	// Single pass over graph vertices for borders and internal edges count
+	std::vector<V> vertexEdges(vertexCount, 0);
+	std::vector<char> unconnected(vertexCount, 0);
+
+	#pragma omp parallel for schedule(dynamic, 1024)
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		if (membership->label[v] == NO_CLUSTER)
+		{
+			continue;
+		}
 
-		// Reset border variable for backward star check
-		isBorder = false;
-		outEdges.clear();
+		scan_t scan = _scan(v, membership->label, *referenceGraph);
+		vertexEdges[v] = scan.edges;
+		membership->border[v] = scan.border;
+		unconnected[v] = scan.unconnected && communities[membership->label[v]].size() > 1;
+	}
 
-		// Check backward star for edges coming from outside the graph
-		const auto& bs = _referenceGraph->backwardStar(v);
-		for (auto& e : bs)
+	// Exceptions cannot leave a parallel region, report unconnected vertices here
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		if (unconnected[v])
 		{
-			if (auto src = orderedVertices.find(e.first); src == orderedVertices.end())
-			{
-				isBorder = true;
-				outEdges.push_back(e.first);
-			}
+			_unconnected(v);
 		}
+	}
+
+	// Collect edges count and border vertices of each sub-graph
+	std::vector<std::shared_ptr<SubGraph<V, W>>> subGraphs(communities.size());
 
-		// If vertex has been detected as border store a consistent backward star contained in sub-graph
-		if (isBorder)
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (size_t c = 0; c < communities.size(); ++c)
+	{
+		auto subGraph = std::shared_ptr<SubGraph<V, W>>(
+			new SubGraph<V, W>(communities[c], referenceGraph, membership, c));
+
+		for (const auto& v : communities[c])
 		{
-			// Copy backward star from reference graph removing each unnecessary external edge
-			_borderSrcWeight[v] = std::map<V, W>(bs);
-			for (auto& out : outEdges)
+			subGraph->_edges += vertexEdges[v];
+
+			if (membership->border[v])
 			{
-				_borderSrcWeight[v].erase(out);
+				subGraph->_borderVertices.insert(v);
 			}
-			connections += _borderSrcWeight[v].size();
+		}
 
-			_borderVertices.insert(v);
+		subGraphs[c] = subGraph;
+	}
+
+	return subGraphs;
+}
+
+template<typename V, typename W>
+typename fastbc::SubGraph<V, W>::scan_t fastbc::SubGraph<V, W>::_scan(
+	V v,
+	const std::vector<V>& label,
+	const IGraph<V, W>& graph)
+{
+	scan_t scan;
+	V connections = 0;
+
+	// Check vertex forward star for edges terminating outside the sub-graph
+	for (const auto& e : graph.forwardStar(v))
+	{
+		if (label[e.first] == label[v])
+		{
+			++scan.edges;
+		}
+		else
+		{
+			scan.border = true;
 		}
+	}
+	connections += scan.edges;
 
-		// If a vertex runs out of edges, the sub-graph is not consistent
-		if (isBorder && !connections && !(_vertices.size() == 1))
+	// Check backward star for edges coming from outside the sub-graph
+	for (const auto& e : graph.backwardStar(v))
+	{
+		if (label[e.first] == label[v])
+		{
+			++connections;
+		}
+		else
 		{
-			SPDLOG_TRACE("Vertex {} is unconnected in its cluster", v);
+			scan.border = true;
+		}
+	}
+
+	scan.unconnected = scan.border && !connections;
+
+	return scan;
+}
+
+template<typename V, typename W>
+void fastbc::SubGraph<V, W>::_unconnected(V v)
+{
+	// Vertex is only used by log macros, which can be compiled out
+	(void)v;
+	SPDLOG_TRACE("Vertex {} is unconnected in its cluster", v);
 
 #ifdef FASTBC_SUBGRAPH_CONNECTED_ONLY
-			SPDLOG_CRITICAL("Vertex {} is unconnected in its cluster", v);
-			throw std::invalid_argument("Given subgraph has unconnected vertices");
+	SPDLOG_CRITICAL("Vertex {} is unconnected in its cluster", v);
+	throw std::invalid_argument("Given subgraph has unconnected vertices");
 #endif
-		}
-	}
 }
 
 template<typename V, typename W>
 W fastbc::SubGraph<V, W>::edge(V src, V dest) const
 {
-	const auto& fs = forwardStar(src);
+	const auto fs = forwardStar(src);
 
 	if (auto w = fs.find(dest); w != fs.end())
 	{
@@ -163,11 +320,12 @@ W fastbc::SubGraph<V, W>::edge(V src, V dest) const
 }
 
 template<typename V, typename W>
-const std::map<V, W>& fastbc::SubGraph<V, W>::forwardStar(V src) const
+fastbc::EdgeSpan<V, W> fastbc::SubGraph<V, W>::forwardStar(V src) const
 {
-	if (auto border = _borderDestWeight.find(src); border != _borderDestWeight.end())
+	// Only border vertices have edges leaving the sub-graph
+	if (_membership->border[src])
 	{
-		return border->second;
+		return EdgeSpan<V, W>(_referenceGraph->forwardStar(src), _membership->label.data(), _cluster);
 	}
 	else
 	{
@@ -176,11 +334,11 @@ const std::map<V, W>& fastbc::SubGraph<V, W>::forwardStar(V src) const
 }
 
 template<typename V, typename W>
-const std::map<V, W>& fastbc::SubGraph<V, W>::backwardStar(V dest) const
+fastbc::EdgeSpan<V, W> fastbc::SubGraph<V, W>::backwardStar(V dest) const
 {
-	if (auto border = _borderSrcWeight.find(dest); border != _borderSrcWeight.end())
+	if (_membership->border[dest])
 	{
-		return border->second;
+		return EdgeSpan<V, W>(_referenceGraph->backwardStar(dest), _membership->label.data(), _cluster);
 	}
 	else
 	{
@@ -209,7 +367,7 @@ const std::set<V>& fastbc::SubGraph<V, W>::borders() const
 template<typename V, typename W>
 bool fastbc::SubGraph<V, W>::isBorder(V vertex) const
 {
-	return _borderVertices.find(vertex) != _borderVertices.end();
+	return _membership->label[vertex] == _cluster && _membership->border[vertex];
 }
 
 template<typename V, typename W>
@@ -218,4 +376,4 @@ std::shared_ptr<const fastbc::IGraph<V, W>> fastbc::SubGraph<V, W>::referenceGra
 	return _referenceGraph;
 }
 
-#endif
\ No newline at end of file
+#endif
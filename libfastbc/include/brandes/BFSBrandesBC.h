@@ -0,0 +1,56 @@
+#ifndef FASTBC_BRANDES_BFSBRANDESBC_H
+#define FASTBC_BRANDES_BFSBRANDESBC_H
+
+#include "IBrandesBC.h"
+#include "BFSSSBrandesBC.h"
+#include "DependencyAccumulator.h"
+
+#include <memory>
+#include <vector>
+
+#include <omp.h>
+
+namespace fastbc {
+	namespace brandes {
+
+		/**
+		 *	@brief Exact Brandes' BC for graphs whose edges share the same weight
+		 *
+		 *	@details Every vertex is used as source of a breadth first single source
+		 *			 Brandes' computation, see BFSSSBrandesBC.
+		 *
+		 *	@note Results are only correct when all graph edges have the same weight
+		 */
+		template<typename V, typename W>
+		class BFSBrandesBC : public IBrandesBC<V, W>
+		{
+		public:
+			std::vector<W> computeBC(const std::shared_ptr<const IGraph<V, W>> graph) override;
+
+		private:
+			BFSSSBrandesBC<V, W> _ssb;
+		};
+
+	}
+}
+
+template<typename V, typename W>
+std::vector<W> fastbc::brandes::BFSBrandesBC<V, W>::computeBC(
+	const std::shared_ptr<const IGraph<V, W>> graph)
+{
+	// Dependencies are summed as double, converted to weight type once done
+	std::vector<double> globalBC(graph->vertices().size(), 0.0);
+
+	// Sum single source dependency from each graph vertex
+	DependencyAccumulator<V, W> accumulator(globalBC, omp_get_max_threads());
+	accumulator.accumulate(graph->vertices().size(),
+		[this, &graph](size_t source, SSBrandesWorkspace<V, W>& workspace)
+		{
+			_ssb.singleSourceBrandes(graph->vertices()[source], graph, workspace);
+			return 1.0;
+		});
+
+	return std::vector<W>(globalBC.begin(), globalBC.end());
+}
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef FASTBC_BRANDES_BFSSSBRANDESBC_H
+#define FASTBC_BRANDES_BFSSSBRANDESBC_H
+
+#include "ISSBrandesBC.h"
+
+#include <limits>
+#include <vector>
+
+namespace fastbc {
+	namespace brandes {
+
+		/**
+		 *	@brief Single source Brandes' BC for graphs whose edges share the same weight
+		 *
+		 *	@details Shortest paths are computed by a queue based breadth first visit
+		 *			 storing each vertex level, so no priority queue is needed. Shortest
+		 *			 path successors are recovered during backtracking from the levels.
+		 *
+		 *	@note Results are only correct when all graph edges have the same weight
+		 */
+		template<typename V, typename W>
+		class BFSSSBrandesBC : public ISSBrandesBC<V, W>
+		{
+		public:
+			using ISSBrandesBC<V, W>::singleSourceBrandes;
+
+			void singleSourceBrandes(
+				V source,
+				std::shared_ptr<const IGraph<V, W>> graph,
+				SSBrandesWorkspace<V, W>& workspace) override;
+
+		private:
+
+			void _bfs_SSSP(
+				V src,
+				std::shared_ptr<const IGraph<V, W>> graph,
+				SSBrandesWorkspace<V, W>& workspace);
+
+			void _backtrack(
+				V src,
+				std::shared_ptr<const IGraph<V, W>> graph,
+				SSBrandesWorkspace<V, W>& workspace);
+		};
+
+	}
+}
+
+template<typename V, typename W>
+void fastbc::brandes::BFSSSBrandesBC<V, W>::singleSourceBrandes(
+	V source,
+	std::shared_ptr<const IGraph<V, W>> graph,
+	SSBrandesWorkspace<V, W>& workspace)
+{
+	_bfs_SSSP(source, graph, workspace);
+	_backtrack(source, graph, workspace);
+}
+
+template<typename V, typename W>
+void fastbc::brandes::BFSSSBrandesBC<V, W>::_bfs_SSSP(
+	V src,
+	std::shared_ptr<const IGraph<V, W>> graph,
+	SSBrandesWorkspace<V, W>& workspace)
+{
+	// Clear entries reached by previous source
+	workspace.reset(graph->vertices().size());
+
+	// Level of each vertex from source and number of shortest paths reaching it
+	auto& level = workspace.dist;
+	auto& sigma = workspace.sigma;
+
+	// BFS queue, it also holds vertices in visit order
+	auto& visitQueue = workspace.visitOrder;
+
+	// Init src information
+	level[src] = 0;
+	sigma[src] = 1;
+	visitQueue.push_back(src);
+
+	for (size_t head = 0; head < visitQueue.size(); ++head)
+	{
+		V v = visitQueue[head];
+		W nextLevel = level[v] + 1;
+
+		// Check the neighbors w of v.
+		for (const auto& it : graph->forwardStar(v))
+		{
+			V w = it.first;
+
+			// Node w found for the first time?
+			if (level[w] == std::numeric_limits<W>::max())
+			{
+				level[w] = nextLevel;
+				visitQueue.push_back(w);
+			}
+
+			// Is the shortest path to w via v?
+			if (level[w] == nextLevel)
+			{
+				sigma[w] += sigma[v];
+			}
+		}
+	}
+}
+
+template<typename V, typename W>
+void fastbc::brandes::BFSSSBrandesBC<V, W>::_backtrack(
+	V src,
+	std::shared_ptr<const IGraph<V, W>> graph,
+	SSBrandesWorkspace<V, W>& workspace)
+{
+	const auto& visitOrder = workspace.visitOrder;
+	const auto& level = workspace.dist;
+	const auto& sigma = workspace.sigma;
+	auto& delta = workspace.delta;
+
+	// Backward visit of each vertex, pulling dependency from next level successors
+	for (size_t i = visitOrder.size(); i-- > 0;)
+	{
+		V v = visitOrder[i];
+		W nextLevel = level[v] + 1;
+
+		for (const auto& it : graph->forwardStar(v))
+		{
+			V w = it.first;
+
+			if (level[w] == nextLevel)
+			{
+				delta[v] += sigma[v] / sigma[w] * (1.0 + delta[w]);
+			}
+		}
+	}
+
+	// Source does not gain dependency from its own paths
+	delta[src] = 0;
+}
+
+#endif
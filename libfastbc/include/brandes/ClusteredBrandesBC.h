@@ -1,18 +1,23 @@
 #ifndef FASTBC_BRANDES_CLUSTEREDBRANDESBC_H
 #define FASTBC_BRANDES_CLUSTEREDBRANDESBC_H
 
+#include "DependencyAccumulator.h"
 #include "IBrandesBC.h"
 #include "IClusterEvaluator.h"
 #include "ISSBrandesBC.h"
 #include "IPivotSelector.h"
-#include "VertexInfo.h"
+#include "VertexInfoMatrix.h"
 #include <IGraphPartition.h>
 #include <SubGraph.h>
 
+#include <algorithm>
 #include <memory>
 #include <spdlog/spdlog.h>
+#include <utility>
 #include <vector>
 
+#include <omp.h>
+
 namespace fastbc {
 	namespace brandes {
 
@@ -67,9 +72,6 @@ std::vector<W> fastbc::brandes::ClusteredBrandeBC<V, W>::computeBC(
 	// Global betweenness centrality storage
 	std::vector<W> globalBC(graph->vertices().size(), (W)0);
 
-	// Vertices topological information about their own cluster border vertices
-	std::vector<std::shared_ptr<VertexInfo<V, W>>> verticesInfo(graph->vertices().size(), nullptr);
-
 	// Computed subgraph and border vertices from each vertices community
 	std::vector<std::shared_ptr<ISubGraph<V, W>>> cluster;
 
@@ -82,90 +84,122 @@ std::vector<W> fastbc::brandes::ClusteredBrandeBC<V, W>::computeBC(
 		_gp->partitionGraph(std::static_pointer_cast<const IDegreeGraph<V, W>>(graph));
 
 	SPDLOG_INFO("Graph partitioned in {} clusters", communities.size());
-	cluster.resize(communities.size());
 	pivotsCluster.resize(communities.size());
 
-	// For each detected community compute related sub-graph, evaluate it for internal BC
-	// and perform topological analysis to get pivots and vertices class cardinality
-	SPDLOG_INFO("Evaluating intra cluster BC...");
-	#pragma omp parallel for
-	for (int i = 0; i < cluster.size(); i++)
+	// Compute related sub-graph of each detected community, sharing vertices cluster labels
+	auto subGraphs = SubGraph<V, W>::fromPartition(communities, graph);
+	cluster.assign(subGraphs.begin(), subGraphs.end());
+
+	// Estimate evaluation cost of each cluster: shortest paths from each vertex
+	// plus border information, then sort clusters by decreasing cost
+	std::vector<double> clusterCost(cluster.size());
+	std::vector<size_t> clusterOrder(cluster.size());
+	for (size_t i = 0; i < cluster.size(); i++)
 	{
-		cluster[i] = std::make_shared<SubGraph<V, W>>(communities[i], graph);
+		clusterCost[i] = (double)cluster[i]->vertices().size() *
+			((double)cluster[i]->edges() + (double)cluster[i]->borders().size());
+		clusterOrder[i] = i;
+	}
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(),
+		[&clusterCost](size_t lhs, size_t rhs) { return clusterCost[lhs] > clusterCost[rhs]; });
 
-		SPDLOG_DEBUG("Evaluating BC on cluster {}: {} vertices ({} borders), {} edges", 
-			i, cluster[i]->vertices().size(), cluster[i]->borders().size(), cluster[i]->edges());
+	// Evaluate each cluster for internal BC and perform topological analysis to get pivots
+	// and vertices class cardinality. Each cluster is a task, started from the most expensive:
+	// large clusters split their sources in further tasks while small ones fill idle threads
+	SPDLOG_INFO("Evaluating intra cluster BC...");
+	#pragma omp parallel
+	#pragma omp single
+	for (const auto& i : clusterOrder)
+	{
+		#pragma omp task firstprivate(i) shared(cluster, pivotsCluster, globalBC)
+		{
+			SPDLOG_DEBUG("Evaluating BC on cluster {}: {} vertices ({} borders), {} edges", 
+				i, cluster[i]->vertices().size(), cluster[i]->borders().size(), cluster[i]->edges());
 		
 #ifndef FASTBC_BRANDES_CLUSTERED_IGNORE_UNCONNECTED
-		if (cluster[i]->borders().empty())
-		{
-			SPDLOG_WARN("Cluster {} ({} vertices, {} edges) is disconnected from the rest of the graph.", 
-				i, cluster[i]->vertices().size(), cluster[i]->edges());
-		}
+			if (cluster[i]->borders().empty())
+			{
+				SPDLOG_WARN("Cluster {} ({} vertices, {} edges) is disconnected from the rest of the graph.", 
+					i, cluster[i]->vertices().size(), cluster[i]->edges());
+			}
 #else
-		if (!cluster[i]->borders().empty())
-		{
+			if (!cluster[i]->borders().empty())
+			{
 #endif
 		
-		_ce->evaluateCluster(globalBC, verticesInfo, cluster[i]);
+			// Vertices topological information about their own cluster border vertices
+			VertexInfoMatrix<V, W> clusterVI;
+
+			_ce->evaluateCluster(globalBC, clusterVI, cluster[i]);
 
-		pivotsCluster[i] = _ps->selectPivots(
-			globalBC, verticesInfo, 
-			cluster[i]->vertices(), cluster[i]->borders());
+			pivotsCluster[i] = _ps->selectPivots(
+				globalBC, clusterVI, 
+				cluster[i]->vertices(), cluster[i]->borders());
 
-		SPDLOG_DEBUG("Selected {} vertices as pivots in cluster {}", pivotsCluster[i].first.size(), i);
+			SPDLOG_DEBUG("Selected {} vertices as pivots in cluster {}", pivotsCluster[i].first.size(), i);
 		
 #ifdef FASTBC_BRANDES_CLUSTERED_IGNORE_UNCONNECTED
-		}
+			}
 #endif
+		}
 	}
 
+	_ps->logSummary();
+
 	// Store computed intra-cluster BC for corrections on 
 	// following global BC computation step
 	std::vector<W> intraClusterBC(globalBC);
+
+	// Pivots dependencies are summed as double, converted to weight type once done
+	std::vector<double> pivotBC(globalBC.begin(), globalBC.end());
 	
-	// Print total number of selected pivots
-#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
-	size_t pivotCount = 0;
-	#pragma omp simd reduction(+:pivotCount)
+	// Flatten pivots of all clusters in a single task list with related class cardinality
+	std::vector<std::pair<V, double>> pivotTasks;
 	for (size_t c = 0; c < pivotsCluster.size(); ++c)
 	{
-		pivotCount += pivotsCluster[c].first.size();
+		for (size_t p = 0; p < pivotsCluster[c].first.size(); ++p)
+		{
+			pivotTasks.emplace_back(pivotsCluster[c].first[p], (double)(pivotsCluster[c].second[p]));
+		}
 	}
-	SPDLOG_INFO("Computing global BC from {} pivots...", pivotCount);
-#endif
 
-	// Compute global dependecy contribution for each selected pivot
-	W* _globalBC = globalBC.data();
-	size_t _globalBCsize = globalBC.size();
+	// Print total number of selected pivots
+	SPDLOG_INFO("Computing global BC from {} pivots...", pivotTasks.size());
+
+	// Compute global dependecy contribution for each selected pivot: pivots of all clusters
+	// are pulled dynamically by the threads
+	DependencyAccumulator<V, W> accumulator(pivotBC, omp_get_max_threads());
+	accumulator.accumulate(pivotTasks.size(),
+		[this, &graph, &pivotTasks](size_t task, SSBrandesWorkspace<V, W>& workspace)
+		{
+			SPDLOG_DEBUG("Computing SSSP from pivot vertex {}", pivotTasks[task].first);
+			_ssb->singleSourceBrandes(pivotTasks[task].first, graph, workspace);
+			return pivotTasks[task].second;
+		});
+
+	// Subtract duplicate dependency from each pivot's cluster vertices, 
+	// clusters are disjoint so each one can be updated independently
+	#pragma omp parallel for schedule(dynamic, 1)
 	for (size_t c = 0; c < cluster.size(); ++c)
 	{
-		#pragma omp parallel for reduction(+:_globalBC[:_globalBCsize])
-		for (size_t p = 0; p < pivotsCluster[c].first.size(); ++p)
+		double classesCardinality = 0;
+		for (const auto& card : pivotsCluster[c].second)
 		{
-			SPDLOG_DEBUG("Computing SSSP from pivot vertex {}", pivotsCluster[c].first[p]);
-			std::vector<W> pivotDependency = 
-				_ssb->singleSourceBrandes(pivotsCluster[c].first[p], graph);
-
-			// Sum pivot dependecy to all vertices
-			#pragma omp simd
-			for(size_t v = 0; v < _globalBCsize; ++v)
-			{
-				_globalBC[v] += pivotDependency[v] * (W)(pivotsCluster[c].second[p]);
-			}
+			classesCardinality += (double)card;
+		}
 
-			// Subtract duplicate dependency from current pivot's cluster vertices
-			#pragma omp simd
-			for (size_t vIndex = 0; vIndex < cluster[c]->vertices().size(); ++vIndex)
-			{
-				const V& v = cluster[c]->vertices()[vIndex];
+		if (classesCardinality == 0)
+		{
+			continue;
+		}
 
-				_globalBC[v] -= intraClusterBC[v] * (W)(pivotsCluster[c].second[p]);
-			}
+		for (const auto& v : cluster[c]->vertices())
+		{
+			pivotBC[v] -= intraClusterBC[v] * classesCardinality;
 		}
 	}
 
-	return globalBC;
+	return std::vector<W>(pivotBC.begin(), pivotBC.end());
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,232 @@
+#ifndef FASTBC_BRANDES_DEPENDENCYACCUMULATOR_H
+#define FASTBC_BRANDES_DEPENDENCYACCUMULATOR_H
+
+#include "SSBrandesWorkspace.h"
+
+#include <vector>
+
+#include <omp.h>
+
+namespace fastbc {
+	namespace brandes {
+
+		/**
+		 *	@brief Deterministic parallel accumulation of single source dependencies
+		 *
+		 *	@details Sources are processed in rounds of several sources per thread, pulled
+		 *			 dynamically by the threads. Each source is computed in the workspace of
+		 *			 its thread and staged in its slot: only vertices of the visit order with
+		 *			 non zero dependency are copied, scaled, grouped by shard of consecutive
+		 *			 vertices (a multiple of the cache line size).
+		 *			 Slots are double buffered: threads done with the sources of a round merge
+		 *			 the previous one into the target vector, so the only barrier is the one
+		 *			 closing each merge. Each shard is written by a single thread, which adds
+		 *			 the entries of each slot in order, hence every vertex receives its
+		 *			 contributions in source order, whatever the number of threads.
+		 *			 Memory is one workspace per thread plus the staged entries, at most one
+		 *			 per reached vertex for each of the two rounds slots.
+		 */
+		template<typename V, typename W>
+		class DependencyAccumulator
+		{
+		public:
+
+			/**
+			 *	@brief Initialize an accumulator adding into given target vector
+			 *
+			 *	@param target Vector indexed by vertex receiving the dependencies
+			 *	@param threads Number of threads computing the sources
+			 *	@param slotsPerThread Number of sources of each round for each thread
+			 *	@param shardSize Number of vertices in each shard
+			 */
+			DependencyAccumulator(
+				std::vector<double>& target,
+				size_t threads,
+				size_t slotsPerThread = 4,
+				size_t shardSize = 1024);
+
+			/**
+			 *	@brief Compute given number of sources and add their dependency to the target vector
+			 *
+			 *	@details Opens a parallel region with the accumulator threads. Each call
+			 *			 compute(source, workspace) must leave in workspace the dependency of
+			 *			 the source with given index, and return the weight to scale it by
+			 *
+			 *	@param sourceCount Number of sources, indexed from zero
+			 *	@param compute Single source computation, called concurrently
+			 */
+			template<typename F>
+			void accumulate(size_t sourceCount, F compute);
+
+		private:
+
+			struct slot_t
+			{
+				// Staged vertices and scaled dependencies, grouped by shard
+				std::vector<V> vertex;
+				std::vector<double> value;
+
+				// Entries range of each shard, empty for shards not reached
+				std::vector<size_t> shardBegin;
+				std::vector<size_t> shardEnd;
+				std::vector<size_t> shards;
+			};
+
+			// Replace slot entries with workspace dependency scaled by weight
+			void _stage(slot_t& slot, const SSBrandesWorkspace<V, W>& workspace, double weight);
+
+			// Add slots of given round half to target vector, ends with a barrier
+			void _merge(size_t half);
+
+			std::vector<double>& _target;
+			size_t _shardSize;
+			size_t _shardCount;
+			size_t _roundSize;
+			std::vector<SSBrandesWorkspace<V, W>> _workspaces;
+			std::vector<slot_t> _slots;
+		};
+
+	}
+}
+
+template<typename V, typename W>
+fastbc::brandes::DependencyAccumulator<V, W>::DependencyAccumulator(
+	std::vector<double>& target,
+	size_t threads,
+	size_t slotsPerThread,
+	size_t shardSize)
+	: _target(target),
+	_shardSize(shardSize),
+	_shardCount((target.size() + shardSize - 1) / shardSize),
+	_roundSize(threads * slotsPerThread),
+	_workspaces(threads),
+	_slots(2 * _roundSize)
+{
+	for (auto& slot : _slots)
+	{
+		slot.shardBegin.resize(_shardCount, 0);
+		slot.shardEnd.resize(_shardCount, 0);
+	}
+}
+
+template<typename V, typename W>
+template<typename F>
+void fastbc::brandes::DependencyAccumulator<V, W>::accumulate(size_t sourceCount, F compute)
+{
+	size_t rounds = (sourceCount + _roundSize - 1) / _roundSize;
+
+	#pragma omp parallel num_threads(_workspaces.size())
+	{
+		SSBrandesWorkspace<V, W>& workspace = _workspaces[omp_get_thread_num()];
+
+		for (size_t round = 0; round <= rounds; ++round)
+		{
+			// Sources of current round are staged in one half of the slots
+			if (round < rounds)
+			{
+				#pragma omp for schedule(dynamic, 1) nowait
+				for (size_t slot = 0; slot < _roundSize; ++slot)
+				{
+					size_t source = round * _roundSize + slot;
+					if (source < sourceCount)
+					{
+						double weight = compute(source, workspace);
+						_stage(_slots[(round % 2) * _roundSize + slot], workspace, weight);
+					}
+				}
+			}
+
+			// Meanwhile previous round, completed before last merge barrier, is merged
+			if (round > 0)
+			{
+				_merge((round - 1) % 2);
+			}
+			else
+			{
+				#pragma omp barrier
+			}
+		}
+	}
+}
+
+template<typename V, typename W>
+void fastbc::brandes::DependencyAccumulator<V, W>::_stage(
+	slot_t& slot,
+	const SSBrandesWorkspace<V, W>& workspace,
+	double weight)
+{
+	const auto& visitOrder = workspace.visitOrder;
+	const auto& delta = workspace.delta;
+
+	// Clear entries merged in a previous round
+	for (const auto& shard : slot.shards)
+	{
+		slot.shardBegin[shard] = 0;
+		slot.shardEnd[shard] = 0;
+	}
+	slot.shards.clear();
+
+	// Count contributions of each shard, shard end is used as counter
+	size_t entries = 0;
+	for (const auto& v : visitOrder)
+	{
+		if (delta[v] != 0)
+		{
+			size_t shard = v / _shardSize;
+			if (slot.shardEnd[shard]++ == 0)
+			{
+				slot.shards.push_back(shard);
+			}
+			++entries;
+		}
+	}
+
+	// Assign consecutive entries to each reached shard
+	size_t offset = 0;
+	for (const auto& shard : slot.shards)
+	{
+		size_t count = slot.shardEnd[shard];
+		slot.shardBegin[shard] = offset;
+		slot.shardEnd[shard] = offset;
+		offset += count;
+	}
+
+	// Copy scaled dependencies, moving each shard end to its final value
+	slot.vertex.resize(entries);
+	slot.value.resize(entries);
+	for (const auto& v : visitOrder)
+	{
+		if (delta[v] != 0)
+		{
+			size_t entry = slot.shardEnd[v / _shardSize]++;
+			slot.vertex[entry] = v;
+			slot.value[entry] = weight * delta[v];
+		}
+	}
+}
+
+template<typename V, typename W>
+void fastbc::brandes::DependencyAccumulator<V, W>::_merge(size_t half)
+{
+	double* target = _target.data();
+	slot_t* slots = _slots.data() + half * _roundSize;
+
+	// Each shard is owned by one thread and receives slots in order,
+	// slots are emptied so that a round shorter than the others is not merged twice
+	#pragma omp for schedule(dynamic, 16)
+	for (size_t shard = 0; shard < _shardCount; ++shard)
+	{
+		for (size_t slot = 0; slot < _roundSize; ++slot)
+		{
+			slot_t& s = slots[slot];
+			for (size_t entry = s.shardBegin[shard]; entry < s.shardEnd[shard]; ++entry)
+			{
+				target[s.vertex[entry]] += s.value[entry];
+			}
+
+			s.shardEnd[shard] = s.shardBegin[shard];
+		}
+	}
+}
+
+#endif
@@ -2,17 +2,34 @@
 #define FASTBC_BRANDES_DIJKSTRACLUSTEREVALUATOR_H
 
 #include "IClusterEvaluator.h"
+#include "SSBrandesWorkspace.h"
 
-#include <list>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <set>
-#include <stack>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
+#include <omp.h>
+
 namespace fastbc {
 	namespace brandes {
 
+		/**
+		 *	@brief Cluster evaluator running Dijkstra's shortest paths from each cluster vertex
+		 *
+		 *	@details Cluster vertices are remapped to local indices 0..n-1 and internal
+		 *			 edges are copied once in a compact CSR, so shortest paths run on flat
+		 *			 arrays sized to the cluster. Results are scattered back to global
+		 *			 indices at the end.
+		 *			 Cluster sources are split in chunks of similar work, evaluated as
+		 *			 OpenMP tasks: when called inside a parallel region large clusters
+		 *			 are evaluated by several threads, while a small cluster makes a single
+		 *			 task. Chunk count only depends on cluster size and chunk results are
+		 *			 summed in chunk order, so results do not depend on threads count.
+		 */
 		template<typename V, typename W>
 		class DijkstraClusterEvaluator : public IClusterEvaluator<V, W>
 		{
@@ -20,28 +37,46 @@ namespace fastbc {
 
 			void evaluateCluster(
 				std::vector<W>& clusterBC,
-				std::vector<std::shared_ptr<VertexInfo<V, W>>>& globalVI,
+				VertexInfoMatrix<V, W>& clusterVI,
 				std::shared_ptr<const ISubGraph<V, W>> cluster) override;
 
 		private:
 
-			struct vertex_backtrack_info_t
-			{
-				W sigma = 0;
-				std::list<V> spPred;
-			};
-
-			struct backtrack_info_t
+			/**
+			 *	@brief Edge relaxations targeted by each chunk of cluster sources
+			 */
+			static constexpr size_t CHUNK_WORK = 1 << 20;
+
+			/**
+			 *	@brief Maximum number of chunks a cluster is split into
+			 */
+			static constexpr size_t MAX_CHUNKS = 64;
+
+			/**
+			 *	@brief Cluster vertices summed by each task after a wave of chunks
+			 */
+			static constexpr size_t SUM_GRAIN = 4096;
+
+			/**
+			 *	@brief Cluster internal edges in CSR format, by local index
+			 */
+			struct local_graph_t
 			{
-				std::stack<V> visitStack;
-				std::map<V, vertex_backtrack_info_t> spBacktrack;
+				std::vector<std::uint64_t> offsets;
+				std::vector<V> targets;
+				std::vector<W> weights;
 			};
 
-			backtrack_info_t _dijkstra_SSSP(
-				std::vector<std::shared_ptr<VertexInfo<V, W>>>& globalVI,
+			static void _dijkstra_SSSP(
+				const local_graph_t& graph,
 				V src,
-				std::shared_ptr<const ISubGraph<V, W>> graph);
+				SSBrandesWorkspace<V, W>& workspace);
 
+			static void _backtrack(
+				const local_graph_t& graph,
+				V src,
+				SSBrandesWorkspace<V, W>& workspace,
+				std::vector<double>& localBC);
 		};
 
 	}
@@ -50,133 +85,198 @@ namespace fastbc {
 template<typename V, typename W>
 void fastbc::brandes::DijkstraClusterEvaluator<V, W>::evaluateCluster(
 	std::vector<W>& clusterBC,
-	std::vector<std::shared_ptr<VertexInfo<V, W>>>& globalVI,
+	VertexInfoMatrix<V, W>& clusterVI,
 	std::shared_ptr<const ISubGraph<V, W>> cluster)
 {
-	W* _clusterBC = clusterBC.data();
-	size_t _clusterBCsize = clusterBC.size();
+	const auto& vertices = cluster->vertices();
+	size_t sourceCount = vertices.size();
 
-	#pragma omp parallel
+	// Cluster local index of each vertex
+	std::unordered_map<V, V> localIndex(sourceCount);
+	for (size_t vIndex = 0; vIndex < sourceCount; ++vIndex)
 	{
-		// Partial dependency vertices map
-		std::map<V, W> delta;
-		for (const auto& v : cluster->vertices()) { delta[v] = 0; }
+		localIndex[vertices[vIndex]] = vIndex;
+	}
 
-		// Compute SP from each cluster vertex
-		#pragma omp for reduction(+:_clusterBC[:_clusterBCsize])
-		for (size_t srcIndex = 0; srcIndex < cluster->vertices().size(); ++srcIndex)
+	// Compact copy of cluster internal edges
+	local_graph_t localGraph;
+	localGraph.offsets.resize(sourceCount + 1, 0);
+	localGraph.targets.reserve(cluster->edges());
+	localGraph.weights.reserve(cluster->edges());
+	for (size_t vIndex = 0; vIndex < sourceCount; ++vIndex)
+	{
+		for (const auto& it : cluster->forwardStar(vertices[vIndex]))
 		{
-			const V& src = cluster->vertices()[srcIndex];
+			if (auto w = localIndex.find(it.first); w != localIndex.end())
+			{
+				localGraph.targets.push_back(w->second);
+				localGraph.weights.push_back(it.second);
+			}
+		}
+
+		localGraph.offsets[vIndex + 1] = localGraph.targets.size();
+	}
 
-			// Reset partial dependency structure before starting
-			for (auto& vw : delta) { vw.second = 0; }
+	// Local index of border vertices, in border storage order
+	std::vector<V> localBorders;
+	localBorders.reserve(cluster->borders().size());
+	for (const auto& b : cluster->borders())
+	{
+		localBorders.push_back(localIndex.at(b));
+	}
+
+	// A row of border information for each cluster vertex
+	clusterVI.resize(sourceCount, localBorders.size());
+
+	// Split sources in chunks of similar work, chunk count only depends on cluster size
+	size_t sourceWork = localGraph.targets.size() + sourceCount;
+	size_t grain = std::max<size_t>(1, CHUNK_WORK / std::max<size_t>(1, sourceWork));
+	size_t chunkCount = std::min(MAX_CHUNKS, (sourceCount + grain - 1) / grain);
+
+	// Chunks are evaluated in waves, with a BC buffer for each chunk of a wave
+	size_t waveSize = std::min<size_t>(chunkCount, std::max(1, omp_get_max_threads()));
+	std::vector<std::vector<double>> waveBC(waveSize, std::vector<double>(sourceCount));
+	std::vector<double> localBC(sourceCount, 0.0);
+
+	for (size_t waveBegin = 0; waveBegin < chunkCount; waveBegin += waveSize)
+	{
+		size_t waveEnd = std::min(chunkCount, waveBegin + waveSize);
+
+		#pragma omp taskloop grainsize(1) shared(waveBC, clusterVI, localGraph, localBorders)
+		for (size_t chunk = waveBegin; chunk < waveEnd; ++chunk)
+		{
+			std::vector<double>& chunkBC = waveBC[chunk - waveBegin];
+			std::fill(chunkBC.begin(), chunkBC.end(), 0.0);
 
-			// Compute shortest path storing border information 
-			struct backtrack_info_t bi = _dijkstra_SSSP(globalVI, src, cluster);
-			auto& visitStack = bi.visitStack;
-			auto& backtrackInfo = bi.spBacktrack;
+			// Shortest path buffers sized to the cluster, reused by chunk sources
+			SSBrandesWorkspace<V, W> workspace;
 
-			// Backward visit of each vertex from dijkstra iteration 
-			while (!visitStack.empty())
+			// Compute SP from each chunk source
+			for (size_t srcIndex = sourceCount * chunk / chunkCount;
+				srcIndex < sourceCount * (chunk + 1) / chunkCount; ++srcIndex)
 			{
-				V w = visitStack.top();
-				visitStack.pop();
+				_dijkstra_SSSP(localGraph, srcIndex, workspace);
 
-				// Compute each vertex dependency for current src
-				for (auto& v : backtrackInfo[w].spPred)
+				// Annotate shortest path length and count information from current src to border vertices
+				auto vi = clusterVI.row(srcIndex);
+				for (size_t storeIndex = 0; storeIndex < localBorders.size(); ++storeIndex)
 				{
-					W c = backtrackInfo[v].sigma / backtrackInfo[w].sigma * (1.0 + delta[w]);
+					W borderDist = workspace.dist[localBorders[storeIndex]];
 
-					delta[v] += c;
+					// BE AWARE: SP lentgh from unreached border is converted to zero to enable
+					// 			 correct VertexInfo distance computation
+					vi.setBorderSPLength(storeIndex, borderDist != std::numeric_limits<W>::max() ? borderDist : 0);
+					vi.setBorderSPCount(storeIndex, (W)workspace.sigma[localBorders[storeIndex]]);
 				}
 
-				if (w != src)
-				{
-					_clusterBC[w] += delta[w];
-				}
+				_backtrack(localGraph, srcIndex, workspace, chunkBC);
 			}
 		}
+
+		// Sum wave chunks in chunk order, for a deterministic sum
+		size_t waveChunks = waveEnd - waveBegin;
+		#pragma omp taskloop grainsize(SUM_GRAIN) shared(waveBC, localBC)
+		for (size_t vIndex = 0; vIndex < sourceCount; ++vIndex)
+		{
+			for (size_t chunk = 0; chunk < waveChunks; ++chunk)
+			{
+				localBC[vIndex] += waveBC[chunk][vIndex];
+			}
+		}
+	}
+
+	// Scatter values to global indices
+	for (size_t vIndex = 0; vIndex < sourceCount; ++vIndex)
+	{
+		clusterBC[vertices[vIndex]] += (W)localBC[vIndex];
 	}
 }
 
 template<typename V, typename W>
-struct fastbc::brandes::DijkstraClusterEvaluator<V, W>::backtrack_info_t
-fastbc::brandes::DijkstraClusterEvaluator<V, W>::_dijkstra_SSSP(
-	std::vector<std::shared_ptr<VertexInfo<V, W>>>& globalVI,
+void fastbc::brandes::DijkstraClusterEvaluator<V, W>::_dijkstra_SSSP(
+	const local_graph_t& graph,
 	V src,
-	std::shared_ptr<const ISubGraph<V, W>> graph)
+	SSBrandesWorkspace<V, W>& workspace)
 {
-	// Output information data structure
-	struct backtrack_info_t backtrackInfo;
-	auto& visitStack = backtrackInfo.visitStack;
-	auto& vertexBInfo = backtrackInfo.spBacktrack;
-
-	// Map holding distances from the source.
-	std::map<V, W> dist;
-	for (const auto& v : graph->vertices()) { dist[v] = std::numeric_limits<W>::max(); }
+	// Clear entries reached by previous source
+	workspace.reset(graph.offsets.size() - 1);
+	auto& visitOrder = workspace.visitOrder;
+	auto& dist = workspace.dist;
+	auto& sigma = workspace.sigma;
 
 	// Queue used for the Dijkstra's algorithm. Ordered by nearest vertex to src
-	auto distCmp = [&dist](const V& lhs, const V& rhs) { 
-		if(dist[lhs] == dist[rhs])
-			return lhs < rhs;
-		return dist[lhs] < dist[rhs]; 
-	};
-	std::set<V, decltype(distCmp)> visitQueue(distCmp);
+	auto& visitQueue = workspace.queue;
 
 	// Init src information
-	vertexBInfo[src].sigma = 1;
+	sigma[src] = 1;
 	dist[src] = 0;
-	visitQueue.insert(src);
+	visitQueue.push(src, 0);
 
 	// While there are still elements in the queue.
 	while (!visitQueue.empty())
 	{
 		// Pop the first
-		V v = *visitQueue.begin();
-		visitQueue.erase(visitQueue.begin());
+		V v = visitQueue.pop();
 
-		// Push vertex to visited stack
-		visitStack.push(v);
+		// Append vertex to settle order
+		visitOrder.push_back(v);
 
 		// Check the neighbors w of v.
-		for (const auto& it : graph->forwardStar(v))
+		for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
 		{
-			V w = it.first;
-			W newDist = dist[v] + it.second;
+			V w = graph.targets[e];
+			W newDist = dist[v] + graph.weights[e];
 
 			// Node w found for the first time or the new distance is shorter?
 			if (newDist < dist[w])
 			{
-				visitQueue.erase(w);
 				dist[w] = newDist;
-				visitQueue.insert(w);
-				vertexBInfo[w].spPred.clear();
-				vertexBInfo[w].sigma = 0;
+				visitQueue.pushOrDecrease(w, newDist);
+				sigma[w] = 0;
 			}
 
 			// Is the shortest path to w via u?
 			if (newDist == dist[w])
 			{
-				vertexBInfo[w].spPred.push_back(v);
-				vertexBInfo[w].sigma += vertexBInfo[v].sigma;
+				sigma[w] += sigma[v];
 			}
 		}
 	}
+}
 
-	// Annotate shortest path length and count information from current src to border vertices
-	const auto& borders = graph->borders();
-	V storeIndex = 0;
-	globalVI[src] = std::make_shared<VertexInfo<V, W>>(borders.size());
-	for (const auto& b : borders)
+template<typename V, typename W>
+void fastbc::brandes::DijkstraClusterEvaluator<V, W>::_backtrack(
+	const local_graph_t& graph,
+	V src,
+	SSBrandesWorkspace<V, W>& workspace,
+	std::vector<double>& localBC)
+{
+	const auto& visitOrder = workspace.visitOrder;
+	const auto& dist = workspace.dist;
+	const auto& sigma = workspace.sigma;
+	auto& delta = workspace.delta;
+
+	// Backward visit of each vertex in reverse settle order
+	for (size_t i = visitOrder.size(); i-- > 0;)
 	{
-		// BE AWARE: SP lentgh from unreached border is converted to zero to enable 
-		// 			 correct VertexInfo distance computation
-		globalVI[src]->setBorderSPLength(storeIndex, dist[b] != std::numeric_limits<W>::max() ? dist[b] : 0);
-		globalVI[src]->setBorderSPCount(storeIndex, vertexBInfo[b].sigma);
-		storeIndex++;
-	}
+		V v = visitOrder[i];
+
+		// Pull dependency from shortest path successors, already completed
+		for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+		{
+			V w = graph.targets[e];
 
-	return backtrackInfo;
+			if (dist[v] + graph.weights[e] == dist[w])
+			{
+				delta[v] += sigma[v] / sigma[w] * (1.0 + delta[w]);
+			}
+		}
+
+		if (v != src)
+		{
+			localBC[v] += delta[v];
+		}
+	}
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -3,11 +3,8 @@
 
 #include "ISSBrandesBC.h"
 
-#include <list>
-#include <set>
-#include <stack>
+#include <memory>
 #include <vector>
-#include <utility>
 
 namespace fastbc {
 	namespace brandes {
@@ -16,107 +13,99 @@ namespace fastbc {
 		class DijkstraSSBrandesBC : public ISSBrandesBC<V, W>
 		{
 		public:
-			std::vector<W> singleSourceBrandes(
+			using ISSBrandesBC<V, W>::singleSourceBrandes;
+
+			void singleSourceBrandes(
 				V source,
-				std::shared_ptr<const IGraph<V, W>> graph) override;
+				std::shared_ptr<const IGraph<V, W>> graph,
+				SSBrandesWorkspace<V, W>& workspace) override;
 
 		private:
 
-			struct vertex_backtrack_info_t
-			{
-				W sigma = 0;
-				std::list<V> spPred;
-			};
-
-			struct backtrack_info_t
-			{
-				std::stack<V> visitStack;
-				std::vector<vertex_backtrack_info_t> spBacktrack;
-			};
+			void _backtrack(
+				V src,
+				std::shared_ptr<const IGraph<V, W>> graph,
+				SSBrandesWorkspace<V, W>& workspace);
 
-			backtrack_info_t _dijkstra_SSSP(
+			void _dijkstra_SSSP(
 				V src,
-				std::shared_ptr<const IGraph<V, W>> graph);
+				std::shared_ptr<const IGraph<V, W>> graph,
+				SSBrandesWorkspace<V, W>& workspace);
 		};
 
 	}
 }
 
 template<typename V, typename W>
-std::vector<W> fastbc::brandes::DijkstraSSBrandesBC<V, W>::singleSourceBrandes(
+void fastbc::brandes::DijkstraSSBrandesBC<V, W>::singleSourceBrandes(
 	V source,
-	std::shared_ptr<const IGraph<V, W>> graph)
+	std::shared_ptr<const IGraph<V, W>> graph,
+	SSBrandesWorkspace<V, W>& workspace)
 {
-	// Compute shortest path storing border information 
-	struct backtrack_info_t bi = _dijkstra_SSSP(source, graph);
-	auto& visitStack = bi.visitStack;
-	auto& backtrackInfo = bi.spBacktrack;
-
-	// Partial vertices dependency
-	std::vector<W> delta(graph->vertices().size(), 0);
+	_dijkstra_SSSP(source, graph, workspace);
+	_backtrack(source, graph, workspace);
+}
 
-	std::vector<W> ssBC(graph->vertices().size(), (W)0);
+template<typename V, typename W>
+void fastbc::brandes::DijkstraSSBrandesBC<V, W>::_backtrack(
+	V src,
+	std::shared_ptr<const IGraph<V, W>> graph,
+	SSBrandesWorkspace<V, W>& workspace)
+{
+	const auto& visitOrder = workspace.visitOrder;
+	const auto& dist = workspace.dist;
+	const auto& sigma = workspace.sigma;
+	auto& delta = workspace.delta;
 
-	// Backward visit of each vertex from dijkstra iteration 
-	while (!visitStack.empty())
+	// Backward visit of each vertex in reverse settle order
+	for (size_t i = visitOrder.size(); i-- > 0;)
 	{
-		V w = visitStack.top();
-		visitStack.pop();
+		V v = visitOrder[i];
 
-		// Compute each vertex dependency for current src
-		for (const auto& v : backtrackInfo[w].spPred)
+		// Pull dependency from shortest path successors, already completed
+		for (const auto& it : graph->forwardStar(v))
 		{
-			W c = backtrackInfo[v].sigma / backtrackInfo[w].sigma * (1.0 + delta[w]);
-
-			delta[v] += c;
-		}
+			V w = it.first;
 
-		if (w != source)
-		{
-			ssBC[w] += delta[w];
+			if (dist[v] + it.second == dist[w])
+			{
+				delta[v] += sigma[v] / sigma[w] * (1.0 + delta[w]);
+			}
 		}
 	}
 
-	return ssBC;
+	// Source does not gain dependency from its own paths
+	delta[src] = 0;
 }
 
 template<typename V, typename W>
-struct fastbc::brandes::DijkstraSSBrandesBC<V, W>::backtrack_info_t
-fastbc::brandes::DijkstraSSBrandesBC<V, W>::_dijkstra_SSSP(
+void fastbc::brandes::DijkstraSSBrandesBC<V, W>::_dijkstra_SSSP(
 	V src,
-	std::shared_ptr<const IGraph<V, W>> graph)
+	std::shared_ptr<const IGraph<V, W>> graph,
+	SSBrandesWorkspace<V, W>& workspace)
 {
-	// Output information data structure
-	struct backtrack_info_t backtrackInfo;
-	auto& visitStack = backtrackInfo.visitStack;
-	auto& vertexBInfo = backtrackInfo.spBacktrack;
-	vertexBInfo.resize(graph->vertices().size());
-
-	// Map holding distances from the source.
-	std::vector<W> dist(graph->vertices().size(), std::numeric_limits<W>::max());
+	// Clear entries reached by previous source
+	workspace.reset(graph->vertices().size());
+	auto& visitOrder = workspace.visitOrder;
+	auto& dist = workspace.dist;
+	auto& sigma = workspace.sigma;
 
 	// Queue used for the Dijkstra's algorithm. Ordered by nearest vertex to src
-	auto distCmp = [&dist](const V& lhs, const V& rhs) { 
-		if(dist[lhs] == dist[rhs])
-			return lhs < rhs;
-		return dist[lhs] < dist[rhs]; 
-	};
-	std::set<V, decltype(distCmp)> visitQueue(distCmp);
+	auto& visitQueue = workspace.queue;
 
 	// Init src information
-	vertexBInfo[src].sigma = 1;
+	sigma[src] = 1;
 	dist[src] = 0;
-	visitQueue.insert(src);
+	visitQueue.push(src, 0);
 
 	// While there are still elements in the queue.
 	while (!visitQueue.empty())
 	{
 		// Pop the first
-		V v = *visitQueue.begin();
-		visitQueue.erase(visitQueue.begin());
+		V v = visitQueue.pop();
 
-		// Push vertex to visited stack
-		visitStack.push(v);
+		// Append vertex to settle order
+		visitOrder.push_back(v);
 
 		// Check the neighbors w of v.
 		for (const auto& it : graph->forwardStar(v))
@@ -127,23 +116,18 @@ fastbc::brandes::DijkstraSSBrandesBC<V, W>::_dijkstra_SSSP(
 			// Node w found for the first time or the new distance is shorter?
 			if (newDist < dist[w])
 			{
-				visitQueue.erase(w);
 				dist[w] = newDist;
-				visitQueue.insert(w);
-				vertexBInfo[w].spPred.clear();
-				vertexBInfo[w].sigma = 0;
+				visitQueue.pushOrDecrease(w, newDist);
+				sigma[w] = 0;
 			}
 
 			// Is the shortest path to w via u?
 			if (newDist == dist[w])
 			{
-				vertexBInfo[w].spPred.push_back(v);
-				vertexBInfo[w].sigma += vertexBInfo[v].sigma;
+				sigma[w] += sigma[v];
 			}
 		}
 	}
-
-	return backtrackInfo;
 }
 
 #endif
\ No newline at end of file
@@ -2,7 +2,7 @@
 #define FASTBC_BRANDES_ICLUSTEREVALUATOR_H
 
 #include <ISubGraph.h>
-#include "VertexInfo.h"
+#include "VertexInfoMatrix.h"
 
 #include <memory>
 #include <vector>
@@ -22,17 +22,19 @@ namespace fastbc {
 			 *			 information about distance from border vertices and number of 
 			 *			 shortest paths through them
 			 * 
-			 *	@note clusterBC and globalVI must be already initialized with correct 
-			 *		  size of the global graph referenced by cluster sub-graph. 
+			 *	@note clusterBC must be already initialized with correct size of the
+			 *		  global graph referenced by cluster sub-graph. 
 			 *		  Only cluster vertex indices will be modified during method call.
+			 *		  The method can be called from an OpenMP task and may split its
+			 *		  work in further tasks instead of opening a parallel region.
 			 * 
 			 *	@param clusterBC Computed BC value will be summed to given reference
-			 *	@param globalVI A new VertexInfo will be allocated for each of sub-graph vertices
+			 *	@param clusterVI Resized with a row for each sub-graph vertex, in cluster->vertices() order
 			 *	@param cluster Sub-graph to apply computation to
 			 */
 			virtual void evaluateCluster(
 				std::vector<W>& clusterBC,
-				std::vector<std::shared_ptr<VertexInfo<V, W>>>& globalVI,
+				VertexInfoMatrix<V, W>& clusterVI,
 				std::shared_ptr<const ISubGraph<V,W>> cluster) = 0;
 		};
 
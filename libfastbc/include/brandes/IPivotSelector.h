@@ -1,7 +1,7 @@
 #ifndef FASTBC_BRANDES_IPIVOTSELECTOR_H
 #define FASTBC_BRANDES_IPIVOTSELECTOR_H
 
-#include "VertexInfo.h"
+#include "VertexInfoMatrix.h"
 
 #include <memory>
 #include <set>
@@ -22,20 +22,25 @@ namespace fastbc {
 			 *	@details Generated pivots are vertices with smallest BC in their class and not
 			 *			 border; a class is composed of vertices with equal vertex information 
 			 * 
-			 *	@note Given VertexInfo references will be normalized and class caradinality will
-			 *		  be updated with correct value during the call
+			 *	@note Vertex information is compared after normalization, given rows are not
+			 *		  modified so they can be shared with concurrent readers
 			 * 
 			 *	@param globalBC Betweenness centrality value for each vertex
-			 *	@param verticesInfo Vertex information for each vertex
+			 *	@param verticesInfo Vertex information, a row for each of given vertices
 			 *	@param vertices Vertices to be considered in the computation
 			 *	@param borders Vertices not to be considered as pivot
 			 *	@return std::pair<std::vector<V>, std::vector<V>> Selected pivot vertex indices and related class cardinality
 			 */
 			virtual std::pair<std::vector<V>, std::vector<V>> selectPivots(
 				const std::vector<W>& globalBC, 
-				const std::vector<std::shared_ptr<VertexInfo<V, W>>>& verticesInfo,
+				const VertexInfoMatrix<V, W>& verticesInfo,
 				const std::vector<V>& vertices,
 				const std::set<V>& borders) = 0;
+
+			/**
+			 *	@brief Log a summary of pivots selected since last call, nothing by default
+			 */
+			virtual void logSummary() {}
 		};
 
 	}
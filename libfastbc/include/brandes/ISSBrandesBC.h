@@ -1,9 +1,11 @@
 #ifndef FASTBC_BRANDES_ISSBRANDESBC_H
 #define FASTBC_BRANDES_ISSBRANDESBC_H
 
+#include "SSBrandesWorkspace.h"
 #include <IGraph.h>
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace fastbc {
@@ -23,12 +25,41 @@ namespace fastbc {
 			 *	@param graph Full graph object
 			 *	@return std::vector<W> Partial betweenness centrality value for each graph vertex
 			 */
-			virtual std::vector<W> singleSourceBrandes(
+			std::vector<W> singleSourceBrandes(
 				V source, 
-				std::shared_ptr<const IGraph<V, W>> graph) = 0;
+				std::shared_ptr<const IGraph<V, W>> graph);
+
+			/**
+			 *	@brief Compute exact partial betweenness centrality values from given source vertex
+			 *		   reusing workspace buffers
+			 *
+			 *	@details Partial betweenness centrality is left in workspace delta, only
+			 *			 vertices in workspace visit order have non zero values
+			 *
+			 *	@note graph must be a complete graph (vertex indices from 0 to graph->vertices().size())
+			 *
+			 *	@param source Source vertex
+			 *	@param graph Full graph object
+			 *	@param workspace Buffers reused across calls by the same thread
+			 */
+			virtual void singleSourceBrandes(
+				V source,
+				std::shared_ptr<const IGraph<V, W>> graph,
+				SSBrandesWorkspace<V, W>& workspace) = 0;
 		};
 
 	}
 }
 
+template<typename V, typename W>
+std::vector<W> fastbc::brandes::ISSBrandesBC<V, W>::singleSourceBrandes(
+	V source,
+	std::shared_ptr<const IGraph<V, W>> graph)
+{
+	SSBrandesWorkspace<V, W> workspace;
+	singleSourceBrandes(source, graph, workspace);
+
+	return std::vector<W>(workspace.delta.begin(), workspace.delta.end());
+}
+
 #endif
\ No newline at end of file
@@ -2,11 +2,14 @@
 #define FASTBC_BRANDES_KMEANSPIVOTSELECTOR_H
 
 #include "IPivotSelector.h"
+#include "VertexInfoProjection.h"
 #include <kmeans/IKMeans.h>
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <spdlog/spdlog.h>
+#include <unordered_map>
 
 namespace fastbc {
 	namespace brandes {
@@ -28,26 +31,56 @@ namespace fastbc {
 			 * 	@param kFrac Fraction of exact pivots to exctract using kmeans in second step
 			 * 	@param stopVariance Minimum allowed variance between pivots set to trigger a new kmeans iteration
 			 * 	@param maxIteration Maximumallowed kmeans iterations
+			 * 	@param projectionDimension Dimensions of pivots VertexInfo random projection
+			 * 							   computed before kmeans on clusters with more borders,
+			 * 							   zero to disable it
 			 */
 			KMeansPivotSelector(
 				std::shared_ptr<IPivotSelector<V, W>> exactPivotSelector,
 				std::shared_ptr<kmeans::IKMeans<V, W>> kmeans,
 				double kFrac,
 				W stopVariance = 0,
-				size_t maxIteration = 100);
+				size_t maxIteration = 100,
+				int projectionDimension = 0);
 
 			std::pair<std::vector<V>, std::vector<V>> selectPivots(
 				const std::vector<W>& globalBC,
-				const std::vector<std::shared_ptr<VertexInfo<V, W>>>& verticesInfo,
+				const VertexInfoMatrix<V, W>& verticesInfo,
 				const std::vector<V>& vertices,
 				const std::set<V>& borders) override;
 
+			/**
+			 *	@brief Log, at info level, pivots aggregation and projection distortion
+			 *		   summed over clusters selected since last call, then reset them,
+			 *		   followed by the kmeans summary
+			 */
+			void logSummary() override;
+
 		private:
+
+			/**
+			 *	@brief Pivot pairs sampled to measure projection distortion
+			 */
+			static constexpr size_t DISTORTION_SAMPLES = 64;
+
+			// Mean relative error of projected squared distances on a sample of pivot pairs
+			static W _projectionDistortion(
+				const VertexInfoMatrix<V, W>& pivotInfo,
+				const VertexInfoMatrix<V, W>& projectedInfo);
+
 			std::shared_ptr<IPivotSelector<V, W>> _exactPS;
 			std::shared_ptr<kmeans::IKMeans<V, W>> _kmeans;
 			const double _kFrac;
 			const W _stopVariance;
 			const size_t _maxIteration;
+			const int _projectionDimension;
+
+			// Summary of selections since last logSummary call, updated atomically
+			size_t _clusters = 0;
+			size_t _exactPivots = 0;
+			size_t _pivots = 0;
+			size_t _projectedClusters = 0;
+			W _distortion = 0;
 		};
 	}
 }
@@ -58,12 +91,14 @@ fastbc::brandes::KMeansPivotSelector<V, W>::KMeansPivotSelector(
 	std::shared_ptr<kmeans::IKMeans<V, W>> kmeans,
 	double kFrac,
 	W stopVariance,
-	size_t maxIteration)
+	size_t maxIteration,
+	int projectionDimension)
 	: _exactPS(exactPivotSelector), 
 	_kmeans(kmeans), 
 	_kFrac(kFrac), 
 	_stopVariance(stopVariance),
-	_maxIteration(maxIteration)
+	_maxIteration(maxIteration),
+	_projectionDimension(projectionDimension)
 {
 	if (_kFrac < 0.0 || _kFrac > 1.0)
 	{
@@ -74,13 +109,18 @@ fastbc::brandes::KMeansPivotSelector<V, W>::KMeansPivotSelector(
 	{
 		SPDLOG_WARN("Given max iteration for kmeans pivot selection is low ({})", _maxIteration);
 	}
+
+	if (_projectionDimension < 0)
+	{
+		throw std::invalid_argument("Given projection dimension is negative");
+	}
 }
 
 template<typename V, typename W>
 std::pair<std::vector<V>, std::vector<V>> 
 fastbc::brandes::KMeansPivotSelector<V, W>::selectPivots(
 	const std::vector<W>& globalBC,
-	const std::vector<std::shared_ptr<VertexInfo<V, W>>>& verticesInfo,
+	const VertexInfoMatrix<V, W>& verticesInfo,
 	const std::vector<V>& vertices,
 	const std::set<V>& borders)
 {
@@ -94,12 +134,50 @@ fastbc::brandes::KMeansPivotSelector<V, W>::selectPivots(
 	SPDLOG_TRACE("Aggregating {} pivots in {} super-classes", 
 		pivotIndexCluster.size(), k);
 
+	// Vertex info row of each exact pivot
+	std::unordered_map<V, V> vertexRow(vertices.size());
+	for (size_t row = 0; row < vertices.size(); ++row)
+	{
+		vertexRow[vertices[row]] = row;
+	}
+
+	// Normalized copy of exact pivots info, shared vertices info is left untouched
+	VertexInfoMatrix<V, W> pivotInfo(pivotIndexCluster.size(), verticesInfo.borders());
+	std::vector<V> pivotRow(pivotIndexCluster.size());
+	for (size_t p = 0; p < pivotIndexCluster.size(); ++p)
+	{
+		verticesInfo.row(vertexRow[pivotIndexCluster[p]]).normalizeTo(pivotInfo.row(p));
+		pivotRow[p] = p;
+	}
+
+	// Random projection of pivots info, only when it reduces distance computation cost:
+	// projected rows keep zero counts, so they cost as much as rows with dimension borders
+	const VertexInfoMatrix<V, W>* kmeansInfo = &pivotInfo;
+	VertexInfoMatrix<V, W> projectedInfo;
+	W distortion = 0;
+	if (_projectionDimension > 0 && _projectionDimension < verticesInfo.borders())
+	{
+		projectedInfo = VertexInfoProjection<V, W>(verticesInfo.borders(), _projectionDimension)
+			.project(pivotInfo);
+		kmeansInfo = &projectedInfo;
+		distortion = _projectionDistortion(pivotInfo, projectedInfo);
+
+		SPDLOG_DEBUG("Projected pivots info from {} to {} dimensions, mean squared distance distortion {}",
+			2 * verticesInfo.borders(), _projectionDimension, distortion);
+	}
+
 	// Compute pivots subset through kmeans algorithm
 	// BE AWARE: duplicated pivots can result from kmeans due to the algorithm euristic nature
 	std::pair<std::vector<V>, std::vector<V>> pivotWeight = 
-		_kmeans->computeCentroids(k, pivotIndexCluster, pivotClassCluster, verticesInfo, 
+		_kmeans->computeCentroids(k, pivotRow, pivotClassCluster, *kmeansInfo, 
 			_stopVariance, _maxIteration);
 
+	// Back from centroid rows to vertex indices
+	for (auto& centroid : pivotWeight.first)
+	{
+		centroid = pivotIndexCluster[centroid];
+	}
+
 #ifndef FASTBC_BRANDES_KMENS_PIVOT_ALLOW_DUPLICATED
 	// Remove duplicated pivots from kmeans result
 	std::set<V> uniquePivots;
@@ -127,8 +205,72 @@ fastbc::brandes::KMeansPivotSelector<V, W>::selectPivots(
 			duplicates);
 	}
 #endif
+
+	SPDLOG_DEBUG("Aggregated {} pivots in {} super-classes{}", pivotIndexCluster.size(),
+		pivotWeight.first.size(), kmeansInfo == &pivotInfo ? "" : " on projected pivots info");
+
+	#pragma omp atomic
+	++_clusters;
+	#pragma omp atomic
+	_exactPivots += pivotIndexCluster.size();
+	#pragma omp atomic
+	_pivots += pivotWeight.first.size();
+	if (kmeansInfo != &pivotInfo)
+	{
+		#pragma omp atomic
+		++_projectedClusters;
+		#pragma omp atomic
+		_distortion += distortion;
+	}
 	
 	return pivotWeight;
 }
 
+template<typename V, typename W>
+void fastbc::brandes::KMeansPivotSelector<V, W>::logSummary()
+{
+	SPDLOG_INFO("Kmeans aggregated {} exact pivots in {} pivots ({:.1f}%) over {} clusters",
+		_exactPivots, _pivots, _exactPivots ? 100.0 * _pivots / _exactPivots : 100.0, _clusters);
+
+	if (_projectionDimension > 0)
+	{
+		SPDLOG_INFO("Pivots info projected to {} dimensions in {} clusters, mean squared distance distortion {}",
+			_projectionDimension, _projectedClusters, _projectedClusters ? _distortion / _projectedClusters : 0);
+	}
+
+	_clusters = 0;
+	_exactPivots = 0;
+	_pivots = 0;
+	_projectedClusters = 0;
+	_distortion = 0;
+
+	_kmeans->logSummary();
+}
+
+template<typename V, typename W>
+W fastbc::brandes::KMeansPivotSelector<V, W>::_projectionDistortion(
+	const VertexInfoMatrix<V, W>& pivotInfo,
+	const VertexInfoMatrix<V, W>& projectedInfo)
+{
+	size_t rows = pivotInfo.rows();
+	W error = 0;
+	size_t pairs = 0;
+
+	// Pairs of rows spread over the whole matrix
+	for (size_t i = 0; i < DISTORTION_SAMPLES && rows > 1; ++i)
+	{
+		size_t lhs = i * rows / DISTORTION_SAMPLES;
+		size_t rhs = (lhs + rows / 2 + i) % rows;
+
+		W distance = pivotInfo.row(lhs).squaredDistance(pivotInfo.row(rhs));
+		if (distance > 0)
+		{
+			error += std::abs(projectedInfo.row(lhs).squaredDistance(projectedInfo.row(rhs)) - distance) / distance;
+			++pairs;
+		}
+	}
+
+	return pairs ? error / pairs : 0;
+}
+
 #endif
\ No newline at end of file
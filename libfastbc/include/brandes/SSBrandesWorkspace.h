@@ -0,0 +1,91 @@
+#ifndef FASTBC_BRANDES_SSBRANDESWORKSPACE_H
+#define FASTBC_BRANDES_SSBRANDESWORKSPACE_H
+
+#include <heap/DijkstraQueue.h>
+
+#include <limits>
+#include <vector>
+
+namespace fastbc {
+	namespace brandes {
+
+		/**
+		 *	@brief Reusable buffers for single source Brandes' computations
+		 *
+		 *	@details Buffers are sized to the graph once and kept across calls. Only
+		 *			 entries of vertices reached by the previous source (its visit order)
+		 *			 are reset before a new computation, so a source reaching a small
+		 *			 part of the graph does not pay for the whole graph.
+		 *			 Path counts and dependencies are stored as double whatever the
+		 *			 weight type, so that integral weights do not truncate their ratios.
+		 *			 A workspace must not be shared among threads.
+		 */
+		template<typename V, typename W>
+		class SSBrandesWorkspace
+		{
+		public:
+
+			/**
+			 *	@brief Prepare workspace for a new source on a graph with given vertices count
+			 *
+			 *	@details After the call dist holds infinity and sigma, delta hold zero for
+			 *			 each vertex and the visit order is empty
+			 */
+			void reset(size_t vertexCount);
+
+			/**
+			 *	@brief Reached vertices in settle order
+			 */
+			std::vector<V> visitOrder;
+
+			/**
+			 *	@brief Distance from source (hop count for breadth first kernels)
+			 */
+			std::vector<W> dist;
+
+			/**
+			 *	@brief Number of shortest paths from source
+			 */
+			std::vector<double> sigma;
+
+			/**
+			 *	@brief Source dependency of each vertex, zero for source and unreached vertices
+			 */
+			std::vector<double> delta;
+
+			/**
+			 *	@brief Priority queue for Dijkstra kernels, empty between computations
+			 */
+			heap::DijkstraQueue<V, W> queue;
+		};
+
+	}
+}
+
+template<typename V, typename W>
+void fastbc::brandes::SSBrandesWorkspace<V, W>::reset(size_t vertexCount)
+{
+	if (dist.size() != vertexCount)
+	{
+		// First use or different graph, initialize all entries
+		visitOrder.clear();
+		visitOrder.reserve(vertexCount);
+		dist.assign(vertexCount, std::numeric_limits<W>::max());
+		sigma.assign(vertexCount, 0.0);
+		delta.assign(vertexCount, 0.0);
+		queue.resize(vertexCount);
+		return;
+	}
+
+	// Reset only entries touched by last computation
+	for (const auto& v : visitOrder)
+	{
+		dist[v] = std::numeric_limits<W>::max();
+		sigma[v] = 0;
+		delta[v] = 0;
+	}
+
+	visitOrder.clear();
+}
+
+#endif
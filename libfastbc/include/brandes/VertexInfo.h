@@ -1,6 +1,8 @@
 #ifndef FASTBC_BRANDES_VERTEXINFO_H
 #define FASTBC_BRANDES_VERTEXINFO_H
 
+#include "VertexInfoView.h"
+
 #include <algorithm>
 #include <cmath>
 #include <vector>
@@ -81,12 +83,25 @@ namespace fastbc {
 			 */
 			int borders() const;
 
+			/*
+			 *	@brief Get a view over this instance border SP lengths and counts
+			 */
+			VertexInfoView<V, W> view();
+
+			VertexInfoView<const V, const W> view() const;
+
 			/*
 			 *	@brief Compute euclidean distance between vectors of border SP length and count
 			 */
 			template<typename N, typename E>
 			W squaredDistance(const VertexInfo<N, E>& other) const;
 
+			template<typename N, typename E>
+			W squaredDistance(const VertexInfoView<N, E>& other) const;
+
+			template<typename N, typename E>
+			VertexInfo<V, W>& operator+=(const VertexInfoView<N, E>& other);
+
 			template<typename N, typename E>
 			VertexInfo<V, W>& operator+=(const VertexInfo<N, E>& other);
 
@@ -290,6 +305,43 @@ int fastbc::brandes::VertexInfo<V, W>::borders() const
 	return _borderCount;
 }
 
+template<typename V, typename W>
+fastbc::brandes::VertexInfoView<V, W> fastbc::brandes::VertexInfo<V, W>::view()
+{
+	return VertexInfoView<V, W>(_borderSPLength.data(), _borderSPCount.data(), _borderCount);
+}
+
+template<typename V, typename W>
+fastbc::brandes::VertexInfoView<const V, const W> fastbc::brandes::VertexInfo<V, W>::view() const
+{
+	return VertexInfoView<const V, const W>(_borderSPLength.data(), _borderSPCount.data(), _borderCount);
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+W fastbc::brandes::VertexInfo<V, W>::squaredDistance(const VertexInfoView<N, E>& other) const
+{
+	return view().squaredDistance(other);
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+fastbc::brandes::VertexInfo<V, W>&
+fastbc::brandes::VertexInfo<V, W>::operator+=(const VertexInfoView<N, E>& other)
+{
+	const E* otherLength = other.lengths();
+	const N* otherCount = other.counts();
+
+	#pragma omp simd
+	for (int i = 0; i < _borderCount; ++i)
+	{
+		_borderSPLength[i] += otherLength[i];
+		_borderSPCount[i] += otherCount[i];
+	}
+
+	return *this;
+}
+
 template<typename V, typename W>
 template<typename N, typename E>
 W fastbc::brandes::VertexInfo<V, W>::squaredDistance(const VertexInfo<N, E>& other) const
@@ -0,0 +1,157 @@
+#ifndef FASTBC_BRANDES_VERTEXINFOMATRIX_H
+#define FASTBC_BRANDES_VERTEXINFOMATRIX_H
+
+#include "VertexInfoView.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace fastbc {
+	namespace brandes {
+
+		/*
+		 *	@brief Topological information of all the vertices of a cluster
+		 *
+		 *	@details Border SP lengths and counts are stored in two row-major matrices
+		 *			 with a row for each cluster vertex and a column for each border.
+		 *			 Rows start on a cache line boundary, so distances between rows are
+		 *			 computed streaming over contiguous aligned memory. Rows are accessed
+		 *			 through VertexInfoView objects.
+		 */
+		template<typename V, typename W>
+		class VertexInfoMatrix
+		{
+		public:
+
+			/**
+			 *	@brief Alignment in bytes of each row
+			 */
+			static constexpr size_t ROW_ALIGNMENT = 64;
+
+			VertexInfoMatrix();
+
+			/**
+			 *	@brief Initialize a zero filled matrix
+			 *
+			 *	@param rows Number of vertices
+			 *	@param borderCount Number of borders
+			 */
+			VertexInfoMatrix(size_t rows, int borderCount);
+
+			/**
+			 *	@brief Resize matrix and set all values to zero
+			 */
+			void resize(size_t rows, int borderCount);
+
+			size_t rows() const;
+
+			int borders() const;
+
+			VertexInfoView<V, W> row(size_t index);
+
+			VertexInfoView<const V, const W> row(size_t index) const;
+
+		private:
+
+			template<typename T>
+			struct aligned_allocator_t
+			{
+				typedef T value_type;
+
+				aligned_allocator_t() = default;
+				template<typename U> aligned_allocator_t(const aligned_allocator_t<U>&) {}
+
+				T* allocate(size_t n)
+				{
+					return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(ROW_ALIGNMENT)));
+				}
+
+				void deallocate(T* p, size_t)
+				{
+					::operator delete(p, std::align_val_t(ROW_ALIGNMENT));
+				}
+
+				template<typename U> bool operator==(const aligned_allocator_t<U>&) const { return true; }
+				template<typename U> bool operator!=(const aligned_allocator_t<U>&) const { return false; }
+			};
+
+			// Row size rounded up to a multiple of the alignment
+			template<typename T>
+			static size_t _stride(int borderCount);
+
+			size_t _rows;
+			int _borderCount;
+			size_t _lengthStride;
+			size_t _countStride;
+			std::vector<W, aligned_allocator_t<W>> _length;
+			std::vector<V, aligned_allocator_t<V>> _count;
+		};
+
+	}
+}
+
+template<typename V, typename W>
+fastbc::brandes::VertexInfoMatrix<V, W>::VertexInfoMatrix()
+	: VertexInfoMatrix(0, 0)
+{
+}
+
+template<typename V, typename W>
+fastbc::brandes::VertexInfoMatrix<V, W>::VertexInfoMatrix(size_t rows, int borderCount)
+{
+	resize(rows, borderCount);
+}
+
+template<typename V, typename W>
+void fastbc::brandes::VertexInfoMatrix<V, W>::resize(size_t rows, int borderCount)
+{
+	_rows = rows;
+	_borderCount = borderCount;
+	_lengthStride = _stride<W>(borderCount);
+	_countStride = _stride<V>(borderCount);
+	_length.assign(_rows * _lengthStride, (W)0);
+	_count.assign(_rows * _countStride, (V)0);
+}
+
+template<typename V, typename W>
+size_t fastbc::brandes::VertexInfoMatrix<V, W>::rows() const
+{
+	return _rows;
+}
+
+template<typename V, typename W>
+int fastbc::brandes::VertexInfoMatrix<V, W>::borders() const
+{
+	return _borderCount;
+}
+
+template<typename V, typename W>
+fastbc::brandes::VertexInfoView<V, W> fastbc::brandes::VertexInfoMatrix<V, W>::row(size_t index)
+{
+	return VertexInfoView<V, W>(
+		_length.data() + index * _lengthStride,
+		_count.data() + index * _countStride,
+		_borderCount);
+}
+
+template<typename V, typename W>
+fastbc::brandes::VertexInfoView<const V, const W> fastbc::brandes::VertexInfoMatrix<V, W>::row(size_t index) const
+{
+	return VertexInfoView<const V, const W>(
+		_length.data() + index * _lengthStride,
+		_count.data() + index * _countStride,
+		_borderCount);
+}
+
+template<typename V, typename W>
+template<typename T>
+size_t fastbc::brandes::VertexInfoMatrix<V, W>::_stride(int borderCount)
+{
+	size_t rowBytes = borderCount * sizeof(T);
+	size_t alignedBytes = (rowBytes + ROW_ALIGNMENT - 1) / ROW_ALIGNMENT * ROW_ALIGNMENT;
+
+	return alignedBytes / sizeof(T);
+}
+
+#endif // !FASTBC_BRANDES_VERTEXINFOMATRIX_H
@@ -3,6 +3,11 @@
 
 #include "IPivotSelector.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <spdlog/spdlog.h>
 #include <vector>
@@ -17,9 +22,22 @@ namespace fastbc {
 
 			std::pair<std::vector<V>, std::vector<V>> selectPivots(
 				const std::vector<W>& globalBC,
-				const std::vector<std::shared_ptr<VertexInfo<V, W>>>& verticesInfo,
+				const VertexInfoMatrix<V, W>& verticesInfo,
 				const std::vector<V>& vertices,
 				const std::set<V>& borders) override;
+
+		private:
+
+			/**
+			 *	@brief Vertices hashed and grouped by each task
+			 */
+			static constexpr size_t GROUPING_GRAIN = 256;
+
+			static std::uint64_t _hash(VertexInfoView<const V, const W> vi, W min);
+
+			static bool _sameClass(
+				VertexInfoView<const V, const W> lhs, W lhsMin,
+				VertexInfoView<const V, const W> rhs, W rhsMin);
 		};
 
 	}
@@ -28,47 +46,76 @@ namespace fastbc {
 template<typename V, typename W>
 std::pair<std::vector<V>, std::vector<V>> fastbc::brandes::VertexInfoPivotSelector<V, W>::selectPivots(
 	const std::vector<W>& globalBC,
-	const std::vector<std::shared_ptr<VertexInfo<V, W>>>& verticesInfo,
+	const VertexInfoMatrix<V, W>& verticesInfo,
 	const std::vector<V>& vertices,
 	const std::set<V>& borders)
 {
-	// Vertex info class representative
-	std::vector<std::shared_ptr<VertexInfo<V, W>>> classes;
+	size_t rowCount = vertices.size();
 
-	// Vertices for each class
-	std::vector<std::vector<V>> classMembers;
+	// Open addressing table of class representatives (row + 1, zero when empty)
+	size_t tableSize = 1;
+	while (tableSize < 2 * rowCount) { tableSize <<= 1; }
+	std::unique_ptr<std::atomic<size_t>[]> table(new std::atomic<size_t>[tableSize]);
+	for (size_t slot = 0; slot < tableSize; ++slot)
+	{
+		table[slot].store(0, std::memory_order_relaxed);
+	}
+
+	// Normalized vertex info hash and class representative row of each vertex
+	std::vector<W> rowMin(rowCount);
+	std::vector<std::uint64_t> rowHash(rowCount);
+	std::vector<size_t> representative(rowCount);
 
-	// Add each vertex to a class
-	for (const auto& v : vertices)
+	// Add each vertex to a class: a full comparison is only needed when hashes collide
+	#pragma omp taskloop grainsize(GROUPING_GRAIN) shared(verticesInfo, table, rowMin, rowHash, representative)
+	for (size_t row = 0; row < rowCount; ++row)
 	{
-		std::shared_ptr<VertexInfo<V, W>> vVI = verticesInfo[v];
-		
-		// Normalize VI before comparison to allow correct class aggregation
-		vVI->normalize();
-
-		// Check if a suitable class already exists
-		bool classExists = false;
-		for (V ci = 0; ci < classes.size(); ++ci)
+		// Vertex info is compared as normalized, without modifying it
+		const auto vVI = verticesInfo.row(row);
+		rowMin[row] = vVI.getMinBorderSPLength();
+		rowHash[row] = _hash(vVI, rowMin[row]);
+
+		size_t slot = rowHash[row] & (tableSize - 1);
+		while (true)
 		{
-			const auto& cVI = classes[ci];
+			size_t entry = table[slot].load();
 
-			if (*cVI == *vVI)
+			// Empty slot, current vertex is the representative of a new class
+			if (entry == 0 && table[slot].compare_exchange_strong(entry, row + 1))
 			{
-				classMembers[ci].push_back(v);
-				classExists = true;
+				representative[row] = row;
 				break;
 			}
+
+			// Check if slot class is the vertex one
+			size_t cRow = entry - 1;
+			if (rowHash[cRow] == rowHash[row] &&
+				_sameClass(verticesInfo.row(cRow), rowMin[cRow], vVI, rowMin[row]))
+			{
+				representative[row] = cRow;
+				break;
+			}
+
+			slot = (slot + 1) & (tableSize - 1);
 		}
+	}
 
-		// If no class exists for current vertex generate a new one
-		if (!classExists)
+	// Vertices for each class, classes and their members sorted by first vertex
+	std::vector<std::vector<V>> classMembers;
+	std::vector<size_t> classIndex(rowCount, std::numeric_limits<size_t>::max());
+	for (size_t row = 0; row < rowCount; ++row)
+	{
+		size_t& ci = classIndex[representative[row]];
+		if (ci == std::numeric_limits<size_t>::max())
 		{
-			classes.push_back(vVI);
-			classMembers.push_back(std::vector<V>({ v }));
+			ci = classMembers.size();
+			classMembers.emplace_back();
 		}
+
+		classMembers[ci].push_back(vertices[row]);
 	}
 
-	SPDLOG_TRACE("Found {} topological classes in current cluster", classes.size());
+	SPDLOG_TRACE("Found {} topological classes in current cluster", classMembers.size());
 
 	// Classes pivot and cardinality
 	std::pair<std::vector<V>, std::vector<V>> pivot;
@@ -126,4 +173,49 @@ std::pair<std::vector<V>, std::vector<V>> fastbc::brandes::VertexInfoPivotSelect
 	return pivot;
 }
 
+template<typename V, typename W>
+std::uint64_t fastbc::brandes::VertexInfoPivotSelector<V, W>::_hash(
+	VertexInfoView<const V, const W> vi, W min)
+{
+	auto mix = [](std::uint64_t x)
+	{
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+		return x ^ (x >> 31);
+	};
+
+	std::uint64_t hash = 0;
+	for (int i = 0; i < vi.borders(); ++i)
+	{
+		// Equal normalized lengths must give equal bits, zero sign included
+		W length = vi.lengths()[i] - min;
+		if (length == 0) { length = 0; }
+
+		std::uint64_t lengthBits = 0;
+		std::memcpy(&lengthBits, &length, std::min(sizeof(W), sizeof(lengthBits)));
+
+		hash = mix(hash ^ (std::uint64_t)vi.counts()[i]);
+		hash = mix(hash ^ lengthBits);
+	}
+
+	return hash;
+}
+
+template<typename V, typename W>
+bool fastbc::brandes::VertexInfoPivotSelector<V, W>::_sameClass(
+	VertexInfoView<const V, const W> lhs, W lhsMin,
+	VertexInfoView<const V, const W> rhs, W rhsMin)
+{
+	for (int i = 0; i < lhs.borders(); ++i)
+	{
+		if (lhs.counts()[i] != rhs.counts()[i] ||
+			lhs.lengths()[i] - lhsMin != rhs.lengths()[i] - rhsMin)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef FASTBC_BRANDES_VERTEXINFOPROJECTION_H
+#define FASTBC_BRANDES_VERTEXINFOPROJECTION_H
+
+#include "VertexInfoMatrix.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fastbc {
+	namespace brandes {
+
+		/*
+		 *	@brief Random projection of vertex info to a fixed number of dimensions
+		 *
+		 *	@details Border SP lengths and counts of a vertex form a vector with two
+		 *			 dimensions for each border. The vector is multiplied by a sparse
+		 *			 random matrix (Achlioptas: entries are +1 or -1 with probability
+		 *			 1/6 each, zero otherwise, scaled by sqrt(3 / dimension)), which
+		 *			 preserves squared distances in expectation (Johnson-Lindenstrauss).
+		 *			 Projected vectors are stored as SP lengths of a matrix with
+		 *			 dimension columns and zero SP counts, so squaredDistance between
+		 *			 projected rows approximates the original one. Since projected
+		 *			 counts are still compared, a distance between projected rows costs
+		 *			 as much as one between rows with dimension borders.
+		 */
+		template<typename V, typename W>
+		class VertexInfoProjection
+		{
+		public:
+
+			/**
+			 *	@brief Initialize a random projection
+			 *
+			 *	@param borderCount Number of borders of projected vertex info
+			 *	@param dimension Number of dimensions after projection
+			 *	@param seed Seed of the random projection matrix
+			 */
+			VertexInfoProjection(int borderCount, int dimension, unsigned int seed = 0);
+
+			/**
+			 *	@brief Project each row of given vertex info matrix
+			 */
+			VertexInfoMatrix<V, W> project(const VertexInfoMatrix<V, W>& vertexInfo) const;
+
+			int dimension() const;
+
+		private:
+
+			/**
+			 *	@brief Rows projected by each task
+			 */
+			static constexpr size_t PROJECTION_GRAIN = 256;
+
+			int _borderCount;
+			int _dimension;
+
+			// Non-zero entries of each input dimension (lengths first, then counts)
+			std::vector<size_t> _entryOffset;
+			std::vector<std::pair<int, W>> _entry;
+		};
+
+	}
+}
+
+template<typename V, typename W>
+fastbc::brandes::VertexInfoProjection<V, W>::VertexInfoProjection(
+	int borderCount, int dimension, unsigned int seed)
+	: _borderCount(borderCount), _dimension(dimension), _entryOffset(2 * borderCount + 1, 0)
+{
+	if (_dimension <= 0)
+	{
+		throw std::invalid_argument("Projection dimension must be greater than zero");
+	}
+
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> entry(0, 5);
+	W scale = std::sqrt((W)3 / _dimension);
+
+	for (int i = 0; i < 2 * _borderCount; ++i)
+	{
+		for (int j = 0; j < _dimension; ++j)
+		{
+			switch (entry(generator))
+			{
+			case 0: _entry.emplace_back(j, scale); break;
+			case 1: _entry.emplace_back(j, -scale); break;
+			default: break;
+			}
+		}
+
+		_entryOffset[i + 1] = _entry.size();
+	}
+}
+
+template<typename V, typename W>
+fastbc::brandes::VertexInfoMatrix<V, W> fastbc::brandes::VertexInfoProjection<V, W>::project(
+	const VertexInfoMatrix<V, W>& vertexInfo) const
+{
+	if (vertexInfo.borders() != _borderCount)
+	{
+		throw std::invalid_argument("Vertex info borders differ from projection ones");
+	}
+
+	VertexInfoMatrix<V, W> projected(vertexInfo.rows(), _dimension);
+
+	#pragma omp taskloop grainsize(PROJECTION_GRAIN) shared(vertexInfo, projected)
+	for (size_t row = 0; row < vertexInfo.rows(); ++row)
+	{
+		const auto vVI = vertexInfo.row(row);
+		W* out = projected.row(row).lengths();
+
+		for (int b = 0; b < _borderCount; ++b)
+		{
+			W length = vVI.lengths()[b];
+			W count = vVI.counts()[b];
+
+			for (size_t e = _entryOffset[b]; e < _entryOffset[b + 1]; ++e)
+			{
+				out[_entry[e].first] += _entry[e].second * length;
+			}
+
+			for (size_t e = _entryOffset[_borderCount + b]; e < _entryOffset[_borderCount + b + 1]; ++e)
+			{
+				out[_entry[e].first] += _entry[e].second * count;
+			}
+		}
+	}
+
+	return projected;
+}
+
+template<typename V, typename W>
+int fastbc::brandes::VertexInfoProjection<V, W>::dimension() const
+{
+	return _dimension;
+}
+
+#endif // !FASTBC_BRANDES_VERTEXINFOPROJECTION_H
@@ -0,0 +1,287 @@
+#ifndef FASTBC_BRANDES_VERTEXINFOVIEW_H
+#define FASTBC_BRANDES_VERTEXINFOVIEW_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace fastbc {
+	namespace brandes {
+
+		/*
+		 *	@brief Non-owning view over a vertex topological information
+		 *
+		 *	@details The view references border SP lengths and counts stored in two
+		 *			 contiguous arrays, e.g. a row of a VertexInfoMatrix. Const qualified
+		 *			 V and W types give a read-only view.
+		 */
+		template<typename V, typename W>
+		class VertexInfoView
+		{
+		public:
+			typedef std::remove_const_t<V> count_t;
+			typedef std::remove_const_t<W> length_t;
+
+			/**
+			 *	@brief Initialize a view over borderCount borders info
+			 *
+			 *	@param length First border SP length
+			 *	@param count First border SP count
+			 *	@param borderCount Number of borders
+			 */
+			VertexInfoView(W* length, V* count, int borderCount);
+
+			/**
+			 *	@brief Read-only view from a mutable one
+			 */
+			template<typename N, typename E>
+			VertexInfoView(const VertexInfoView<N, E>& other);
+
+			void setBorderSPLength(int storeIndex, length_t length) const;
+
+			length_t getBorderSPLength(int storeIndex) const;
+
+			void setBorderSPCount(int storeIndex, count_t count) const;
+
+			count_t getBorderSPCount(int storeIndex) const;
+
+			length_t getMinBorderSPLength() const;
+
+			/*
+			 *	@brief Copy border info into dest, subtracting minimum SP length from each border SP length
+			 *
+			 *	@details Viewed info is not modified, so it can be normalized by concurrent readers
+			 */
+			template<typename N, typename E>
+			void normalizeTo(const VertexInfoView<N, E>& dest) const;
+
+			/*
+			 *	@brief Reset all SP lengths and counts to zero
+			 */
+			void reset() const;
+
+			int borders() const;
+
+			/*
+			 *	@brief Contiguous border SP lengths
+			 */
+			W* lengths() const;
+
+			/*
+			 *	@brief Contiguous border SP counts
+			 */
+			V* counts() const;
+
+			/*
+			 *	@brief Compute euclidean distance between vectors of border SP length and count
+			 */
+			template<typename N, typename E>
+			length_t squaredDistance(const VertexInfoView<N, E>& other) const;
+
+			template<typename N, typename E>
+			length_t compare(const VertexInfoView<N, E>& other) const;
+
+			template<typename N, typename E>
+			bool operator==(const VertexInfoView<N, E>& other) const;
+
+			template<typename N, typename E>
+			bool operator!=(const VertexInfoView<N, E>& other) const;
+
+			template<typename N, typename E>
+			bool operator<(const VertexInfoView<N, E>& other) const;
+
+		private:
+			W* _length;
+			V* _count;
+			int _borderCount;
+		};
+
+	}
+}
+
+template<typename V, typename W>
+fastbc::brandes::VertexInfoView<V, W>::VertexInfoView(W* length, V* count, int borderCount)
+	: _length(length), _count(count), _borderCount(borderCount)
+{
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+fastbc::brandes::VertexInfoView<V, W>::VertexInfoView(const VertexInfoView<N, E>& other)
+	: _length(other.lengths()), _count(other.counts()), _borderCount(other.borders())
+{
+}
+
+template<typename V, typename W>
+void fastbc::brandes::VertexInfoView<V, W>::setBorderSPLength(int storeIndex, length_t length) const
+{
+	if (storeIndex < _borderCount)
+	{
+		_length[storeIndex] = length;
+	}
+	else
+	{
+		throw std::out_of_range("Given store index is out of range.");
+	}
+}
+
+template<typename V, typename W>
+typename fastbc::brandes::VertexInfoView<V, W>::length_t
+fastbc::brandes::VertexInfoView<V, W>::getBorderSPLength(int storeIndex) const
+{
+	if (storeIndex < _borderCount)
+	{
+		return _length[storeIndex];
+	}
+	else
+	{
+		throw std::out_of_range("Given store index is out of range.");
+	}
+}
+
+template<typename V, typename W>
+void fastbc::brandes::VertexInfoView<V, W>::setBorderSPCount(int storeIndex, count_t count) const
+{
+	if (storeIndex < _borderCount)
+	{
+		_count[storeIndex] = count;
+	}
+	else
+	{
+		throw std::out_of_range("Given store index is out of range.");
+	}
+}
+
+template<typename V, typename W>
+typename fastbc::brandes::VertexInfoView<V, W>::count_t
+fastbc::brandes::VertexInfoView<V, W>::getBorderSPCount(int storeIndex) const
+{
+	if (storeIndex < _borderCount)
+	{
+		return _count[storeIndex];
+	}
+	else
+	{
+		throw std::out_of_range("Given store index is out of range.");
+	}
+}
+
+template<typename V, typename W>
+typename fastbc::brandes::VertexInfoView<V, W>::length_t
+fastbc::brandes::VertexInfoView<V, W>::getMinBorderSPLength() const
+{
+	// It could be possible to have a sub-grph not connected to external vertices
+	if (!_borderCount) { return 0; }
+
+	return *std::min_element(_length, _length + _borderCount);
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+void fastbc::brandes::VertexInfoView<V, W>::normalizeTo(const VertexInfoView<N, E>& dest) const
+{
+	length_t min = getMinBorderSPLength();
+	E* destLength = dest.lengths();
+	N* destCount = dest.counts();
+
+	#pragma omp simd
+	for (int i = 0; i < _borderCount; ++i)
+	{
+		destLength[i] = _length[i] - min;
+		destCount[i] = _count[i];
+	}
+}
+
+template<typename V, typename W>
+void fastbc::brandes::VertexInfoView<V, W>::reset() const
+{
+	std::fill(_length, _length + _borderCount, (length_t)0);
+	std::fill(_count, _count + _borderCount, (count_t)0);
+}
+
+template<typename V, typename W>
+int fastbc::brandes::VertexInfoView<V, W>::borders() const
+{
+	return _borderCount;
+}
+
+template<typename V, typename W>
+W* fastbc::brandes::VertexInfoView<V, W>::lengths() const
+{
+	return _length;
+}
+
+template<typename V, typename W>
+V* fastbc::brandes::VertexInfoView<V, W>::counts() const
+{
+	return _count;
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+typename fastbc::brandes::VertexInfoView<V, W>::length_t
+fastbc::brandes::VertexInfoView<V, W>::squaredDistance(const VertexInfoView<N, E>& other) const
+{
+	const W* length = _length;
+	const V* count = _count;
+	const E* otherLength = other.lengths();
+	const N* otherCount = other.counts();
+
+	length_t sqDistance = 0;
+
+	#pragma omp simd reduction(+:sqDistance)
+	for (int i = 0; i < _borderCount; ++i)
+	{
+		length_t dLength = length[i] - (length_t)otherLength[i];
+		length_t dCount = count[i] - (count_t)otherCount[i];
+
+		sqDistance += dLength * dLength;
+		sqDistance += dCount * dCount;
+	}
+
+	return sqDistance;
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+typename fastbc::brandes::VertexInfoView<V, W>::length_t
+fastbc::brandes::VertexInfoView<V, W>::compare(const VertexInfoView<N, E>& other) const
+{
+	for (int i = 0; i < _borderCount; i++)
+	{
+		if (length_t cmp = _count[i] - other.counts()[i]; cmp != 0)
+		{
+			return cmp;
+		}
+
+		if (length_t cmp = _length[i] - other.lengths()[i]; cmp != 0)
+		{
+			return cmp;
+		}
+	}
+
+	return 0;
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+bool fastbc::brandes::VertexInfoView<V, W>::operator==(const VertexInfoView<N, E>& other) const
+{
+	return compare(other) == 0;
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+bool fastbc::brandes::VertexInfoView<V, W>::operator!=(const VertexInfoView<N, E>& other) const
+{
+	return compare(other) != 0;
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+bool fastbc::brandes::VertexInfoView<V, W>::operator<(const VertexInfoView<N, E>& other) const
+{
+	return compare(other) < 0;
+}
+
+#endif // !FASTBC_BRANDES_VERTEXINFOVIEW_H
@@ -0,0 +1,29 @@
+#ifndef FASTBC_HEAP_DIJKSTRAQUEUE_H
+#define FASTBC_HEAP_DIJKSTRAQUEUE_H
+
+#include "IndexedDAryHeap.h"
+#include "RadixHeap.h"
+
+#include <type_traits>
+
+namespace fastbc {
+	namespace heap {
+
+		/**
+		 *	@brief Priority queue used by Dijkstra kernels for given distance type
+		 *
+		 *	@details Integral distances use a monotone radix heap, other distance
+		 *			 types use an indexed d-ary heap. Both expose the same interface.
+		 *
+		 *	@tparam K Type for key (index) values
+		 *	@tparam P Type for distance values
+		 */
+		template<typename K, typename P>
+		using DijkstraQueue = typename std::conditional<std::is_integral<P>::value,
+			RadixHeap<K, P>,
+			IndexedDAryHeap<K, P>>::type;
+
+	}
+}
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef FASTBC_HEAP_INDEXEDDARYHEAP_H
+#define FASTBC_HEAP_INDEXEDDARYHEAP_H
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace fastbc {
+	namespace heap {
+
+		/**
+		 *	@brief Indexed min d-ary heap with in-place decrease-key
+		 *
+		 *	@details Keys are indices in [0, capacity) and each key position inside the
+		 *			 heap is tracked in a dense array, giving O(1) lookup and allowing
+		 *			 priorities to be decreased without erase/insert. Priorities are stored
+		 *			 next to their keys, so no external array is read while sifting.
+		 *			 Equal priorities are ordered by increasing key.
+		 *
+		 *	@tparam K Type for key (index) values
+		 *	@tparam P Type for priority values
+		 *	@tparam D Heap arity
+		 */
+		template<typename K, typename P, unsigned D = 4>
+		class IndexedDAryHeap
+		{
+			static_assert(D >= 2, "Heap arity must be at least 2");
+
+		public:
+
+			/**
+			 *	@brief Initialize an empty heap for keys in [0, capacity)
+			 */
+			IndexedDAryHeap(size_t capacity = 0);
+
+			/**
+			 *	@brief Change allowed keys range to [0, capacity), the heap must be empty
+			 */
+			void resize(size_t capacity);
+
+			size_t capacity() const;
+
+			size_t size() const;
+
+			bool empty() const;
+
+			bool contains(K key) const;
+
+			/**
+			 *	@brief Insert key with given priority, key must not be in the heap
+			 */
+			void push(K key, P priority);
+
+			/**
+			 *	@brief Decrease priority of a key already in the heap
+			 */
+			void decrease(K key, P priority);
+
+			/**
+			 *	@brief Insert key or decrease its priority if already in the heap
+			 */
+			void pushOrDecrease(K key, P priority);
+
+			/**
+			 *	@brief Get key with minimum priority
+			 */
+			K top() const;
+
+			/**
+			 *	@brief Get minimum priority
+			 */
+			P topPriority() const;
+
+			/**
+			 *	@brief Remove and return key with minimum priority
+			 */
+			K pop();
+
+			/**
+			 *	@brief Remove all keys, in O(size) time
+			 */
+			void clear();
+
+		private:
+			static constexpr size_t NOT_IN_HEAP = std::numeric_limits<size_t>::max();
+
+			struct entry_t
+			{
+				P priority;
+				K key;
+			};
+
+			std::vector<entry_t> _heap;
+			std::vector<size_t> _position;
+
+			static bool _less(const entry_t& lhs, const entry_t& rhs);
+
+			void _siftUp(size_t index);
+
+			void _siftDown(size_t index);
+		};
+
+	}
+}
+
+template<typename K, typename P, unsigned D>
+fastbc::heap::IndexedDAryHeap<K, P, D>::IndexedDAryHeap(size_t capacity)
+	: _position(capacity, NOT_IN_HEAP)
+{
+}
+
+template<typename K, typename P, unsigned D>
+void fastbc::heap::IndexedDAryHeap<K, P, D>::resize(size_t capacity)
+{
+	if (!_heap.empty())
+	{
+		throw std::logic_error("Heap must be empty to be resized");
+	}
+
+	_position.assign(capacity, NOT_IN_HEAP);
+}
+
+template<typename K, typename P, unsigned D>
+size_t fastbc::heap::IndexedDAryHeap<K, P, D>::capacity() const
+{
+	return _position.size();
+}
+
+template<typename K, typename P, unsigned D>
+size_t fastbc::heap::IndexedDAryHeap<K, P, D>::size() const
+{
+	return _heap.size();
+}
+
+template<typename K, typename P, unsigned D>
+bool fastbc::heap::IndexedDAryHeap<K, P, D>::empty() const
+{
+	return _heap.empty();
+}
+
+template<typename K, typename P, unsigned D>
+bool fastbc::heap::IndexedDAryHeap<K, P, D>::contains(K key) const
+{
+	return _position[key] != NOT_IN_HEAP;
+}
+
+template<typename K, typename P, unsigned D>
+void fastbc::heap::IndexedDAryHeap<K, P, D>::push(K key, P priority)
+{
+	_heap.push_back(entry_t{ priority, key });
+	_position[key] = _heap.size() - 1;
+	_siftUp(_heap.size() - 1);
+}
+
+template<typename K, typename P, unsigned D>
+void fastbc::heap::IndexedDAryHeap<K, P, D>::decrease(K key, P priority)
+{
+	size_t index = _position[key];
+	_heap[index].priority = priority;
+	_siftUp(index);
+}
+
+template<typename K, typename P, unsigned D>
+void fastbc::heap::IndexedDAryHeap<K, P, D>::pushOrDecrease(K key, P priority)
+{
+	if (contains(key))
+	{
+		decrease(key, priority);
+	}
+	else
+	{
+		push(key, priority);
+	}
+}
+
+template<typename K, typename P, unsigned D>
+K fastbc::heap::IndexedDAryHeap<K, P, D>::top() const
+{
+	return _heap.front().key;
+}
+
+template<typename K, typename P, unsigned D>
+P fastbc::heap::IndexedDAryHeap<K, P, D>::topPriority() const
+{
+	return _heap.front().priority;
+}
+
+template<typename K, typename P, unsigned D>
+K fastbc::heap::IndexedDAryHeap<K, P, D>::pop()
+{
+	K key = _heap.front().key;
+	_position[key] = NOT_IN_HEAP;
+
+	// Move last entry to the root and restore heap order
+	if (_heap.size() > 1)
+	{
+		_heap.front() = _heap.back();
+		_position[_heap.front().key] = 0;
+		_heap.pop_back();
+		_siftDown(0);
+	}
+	else
+	{
+		_heap.pop_back();
+	}
+
+	return key;
+}
+
+template<typename K, typename P, unsigned D>
+void fastbc::heap::IndexedDAryHeap<K, P, D>::clear()
+{
+	for (const auto& e : _heap)
+	{
+		_position[e.key] = NOT_IN_HEAP;
+	}
+
+	_heap.clear();
+}
+
+template<typename K, typename P, unsigned D>
+bool fastbc::heap::IndexedDAryHeap<K, P, D>::_less(const entry_t& lhs, const entry_t& rhs)
+{
+	if (lhs.priority == rhs.priority)
+		return lhs.key < rhs.key;
+	return lhs.priority < rhs.priority;
+}
+
+template<typename K, typename P, unsigned D>
+void fastbc::heap::IndexedDAryHeap<K, P, D>::_siftUp(size_t index)
+{
+	entry_t moving = _heap[index];
+
+	// Move parents down until moving entry position is found
+	while (index > 0)
+	{
+		size_t parent = (index - 1) / D;
+		if (!_less(moving, _heap[parent]))
+		{
+			break;
+		}
+
+		_heap[index] = _heap[parent];
+		_position[_heap[index].key] = index;
+		index = parent;
+	}
+
+	_heap[index] = moving;
+	_position[moving.key] = index;
+}
+
+template<typename K, typename P, unsigned D>
+void fastbc::heap::IndexedDAryHeap<K, P, D>::_siftDown(size_t index)
+{
+	entry_t moving = _heap[index];
+	size_t size = _heap.size();
+
+	// Move smallest child up until moving entry position is found
+	while (true)
+	{
+		size_t first = index * D + 1;
+		if (first >= size)
+		{
+			break;
+		}
+
+		size_t last = first + D < size ? first + D : size;
+		size_t minChild = first;
+		for (size_t c = first + 1; c < last; ++c)
+		{
+			if (_less(_heap[c], _heap[minChild]))
+			{
+				minChild = c;
+			}
+		}
+
+		if (!_less(_heap[minChild], moving))
+		{
+			break;
+		}
+
+		_heap[index] = _heap[minChild];
+		_position[_heap[index].key] = index;
+		index = minChild;
+	}
+
+	_heap[index] = moving;
+	_position[moving.key] = index;
+}
+
+#endif
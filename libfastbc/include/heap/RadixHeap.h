@@ -0,0 +1,321 @@
+#ifndef FASTBC_HEAP_RADIXHEAP_H
+#define FASTBC_HEAP_RADIXHEAP_H
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace fastbc {
+	namespace heap {
+
+		/**
+		 *	@brief Indexed monotone radix heap for integral priorities
+		 *
+		 *	@details Entries are placed in buckets by the highest bit in which their
+		 *			 priority differs from the last extracted minimum. Extraction only
+		 *			 scans the bucket holding the new minimum and redistributes it into
+		 *			 lower buckets, so each entry moves at most once per priority bit.
+		 *			 Each key position is tracked, allowing priorities to be decreased
+		 *			 in O(1) by moving the entry to its new bucket.
+		 *			 Keys with equal priority are extracted in unspecified order.
+		 *
+		 *	@note Priorities must be non-negative and never lower than the last
+		 *		  extracted priority (monotone usage, as in Dijkstra's algorithm
+		 *		  with non-negative weights).
+		 *
+		 *	@tparam K Type for key (index) values
+		 *	@tparam P Type for priority values, must be integral
+		 */
+		template<typename K, typename P>
+		class RadixHeap
+		{
+			static_assert(std::is_integral<P>::value, "Radix heap priorities must be integral");
+
+		public:
+
+			/**
+			 *	@brief Initialize an empty heap for keys in [0, capacity)
+			 */
+			RadixHeap(size_t capacity = 0);
+
+			/**
+			 *	@brief Change allowed keys range to [0, capacity), the heap must be empty
+			 */
+			void resize(size_t capacity);
+
+			size_t capacity() const;
+
+			size_t size() const;
+
+			bool empty() const;
+
+			bool contains(K key) const;
+
+			/**
+			 *	@brief Insert key with given priority, key must not be in the heap
+			 */
+			void push(K key, P priority);
+
+			/**
+			 *	@brief Decrease priority of a key already in the heap
+			 */
+			void decrease(K key, P priority);
+
+			/**
+			 *	@brief Insert key or decrease its priority if already in the heap
+			 */
+			void pushOrDecrease(K key, P priority);
+
+			/**
+			 *	@brief Get key with minimum priority
+			 */
+			K top();
+
+			/**
+			 *	@brief Get minimum priority
+			 */
+			P topPriority();
+
+			/**
+			 *	@brief Remove and return key with minimum priority
+			 */
+			K pop();
+
+			/**
+			 *	@brief Remove all keys and restart priorities from zero, in O(size) time
+			 */
+			void clear();
+
+		private:
+			typedef typename std::make_unsigned<P>::type U;
+
+			static constexpr unsigned BUCKETS = std::numeric_limits<U>::digits + 1;
+			static constexpr unsigned NOT_IN_HEAP = std::numeric_limits<unsigned>::max();
+
+			struct entry_t
+			{
+				P priority;
+				K key;
+			};
+
+			struct position_t
+			{
+				unsigned bucket = NOT_IN_HEAP;
+				size_t index = 0;
+			};
+
+			std::vector<entry_t> _bucket[BUCKETS];
+			std::vector<position_t> _position;
+			size_t _size;
+			U _last;
+
+			static unsigned _bitWidth(U value);
+
+			unsigned _bucketIndex(P priority) const;
+
+			void _insert(const entry_t& entry);
+
+			void _erase(K key);
+
+			void _refill();
+		};
+
+	}
+}
+
+template<typename K, typename P>
+fastbc::heap::RadixHeap<K, P>::RadixHeap(size_t capacity)
+	: _position(capacity), _size(0), _last(0)
+{
+}
+
+template<typename K, typename P>
+void fastbc::heap::RadixHeap<K, P>::resize(size_t capacity)
+{
+	if (_size != 0)
+	{
+		throw std::logic_error("Heap must be empty to be resized");
+	}
+
+	_position.assign(capacity, position_t());
+	_last = 0;
+}
+
+template<typename K, typename P>
+size_t fastbc::heap::RadixHeap<K, P>::capacity() const
+{
+	return _position.size();
+}
+
+template<typename K, typename P>
+size_t fastbc::heap::RadixHeap<K, P>::size() const
+{
+	return _size;
+}
+
+template<typename K, typename P>
+bool fastbc::heap::RadixHeap<K, P>::empty() const
+{
+	return _size == 0;
+}
+
+template<typename K, typename P>
+bool fastbc::heap::RadixHeap<K, P>::contains(K key) const
+{
+	return _position[key].bucket != NOT_IN_HEAP;
+}
+
+template<typename K, typename P>
+void fastbc::heap::RadixHeap<K, P>::push(K key, P priority)
+{
+	_insert(entry_t{ priority, key });
+	_size++;
+}
+
+template<typename K, typename P>
+void fastbc::heap::RadixHeap<K, P>::decrease(K key, P priority)
+{
+	_erase(key);
+	_insert(entry_t{ priority, key });
+}
+
+template<typename K, typename P>
+void fastbc::heap::RadixHeap<K, P>::pushOrDecrease(K key, P priority)
+{
+	if (contains(key))
+	{
+		decrease(key, priority);
+	}
+	else
+	{
+		push(key, priority);
+	}
+}
+
+template<typename K, typename P>
+K fastbc::heap::RadixHeap<K, P>::top()
+{
+	_refill();
+	return _bucket[0].back().key;
+}
+
+template<typename K, typename P>
+P fastbc::heap::RadixHeap<K, P>::topPriority()
+{
+	_refill();
+	return _bucket[0].back().priority;
+}
+
+template<typename K, typename P>
+K fastbc::heap::RadixHeap<K, P>::pop()
+{
+	_refill();
+
+	K key = _bucket[0].back().key;
+	_bucket[0].pop_back();
+	_position[key].bucket = NOT_IN_HEAP;
+	_size--;
+
+	return key;
+}
+
+template<typename K, typename P>
+void fastbc::heap::RadixHeap<K, P>::clear()
+{
+	for (auto& bucket : _bucket)
+	{
+		for (const auto& e : bucket)
+		{
+			_position[e.key].bucket = NOT_IN_HEAP;
+		}
+
+		bucket.clear();
+	}
+
+	_size = 0;
+	_last = 0;
+}
+
+template<typename K, typename P>
+unsigned fastbc::heap::RadixHeap<K, P>::_bitWidth(U value)
+{
+#if defined(__GNUC__)
+	return value == 0 ? 0 :
+		std::numeric_limits<unsigned long long>::digits - __builtin_clzll((unsigned long long)value);
+#else
+	unsigned width = 0;
+	while (value != 0)
+	{
+		value >>= 1;
+		width++;
+	}
+	return width;
+#endif
+}
+
+template<typename K, typename P>
+unsigned fastbc::heap::RadixHeap<K, P>::_bucketIndex(P priority) const
+{
+	return _bitWidth((U)priority ^ _last);
+}
+
+template<typename K, typename P>
+void fastbc::heap::RadixHeap<K, P>::_insert(const entry_t& entry)
+{
+	unsigned b = _bucketIndex(entry.priority);
+	_bucket[b].push_back(entry);
+	_position[entry.key].bucket = b;
+	_position[entry.key].index = _bucket[b].size() - 1;
+}
+
+template<typename K, typename P>
+void fastbc::heap::RadixHeap<K, P>::_erase(K key)
+{
+	position_t pos = _position[key];
+	auto& bucket = _bucket[pos.bucket];
+
+	// Fill the hole with bucket last entry
+	bucket[pos.index] = bucket.back();
+	_position[bucket[pos.index].key].index = pos.index;
+	bucket.pop_back();
+
+	_position[key].bucket = NOT_IN_HEAP;
+}
+
+template<typename K, typename P>
+void fastbc::heap::RadixHeap<K, P>::_refill()
+{
+	if (!_bucket[0].empty())
+	{
+		return;
+	}
+
+	// Find first non empty bucket, it holds the new minimum
+	unsigned b = 1;
+	while (_bucket[b].empty())
+	{
+		b++;
+	}
+
+	U minPriority = (U)_bucket[b].front().priority;
+	for (const auto& e : _bucket[b])
+	{
+		if ((U)e.priority < minPriority)
+		{
+			minPriority = (U)e.priority;
+		}
+	}
+
+	// Redistribute bucket entries, all of them move to lower buckets
+	_last = minPriority;
+	for (const auto& e : _bucket[b])
+	{
+		_insert(e);
+	}
+
+	_bucket[b].clear();
+}
+
+#endif
@@ -0,0 +1,386 @@
+#ifndef FASTBC_IO_BINARYGRAPH_H
+#define FASTBC_IO_BINARYGRAPH_H
+
+#include <CSRGraph.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fastbc {
+	namespace io {
+
+		/**
+		 *	@brief Versioned binary snapshot of a CSR graph
+		 *
+		 *	@details File layout is a fixed size header followed by forward offsets,
+		 *			 targets, weights and backward offsets, sources, weights sections.
+		 *			 Each section starts at a 64 bytes aligned position recorded in the
+		 *			 header and stores values in native byte order, so that the whole
+		 *			 file can be memory mapped and used as a CSRGraph without parsing
+		 *			 or copying. Stars are checked when written; mapping only checks
+		 *			 the header, unless a full check of the stars is requested.
+		 *
+		 *	@tparam V Type for vertex index number
+		 *	@tparam W Type for edge weight value
+		 */
+		template<typename V, typename W>
+		class BinaryGraph
+		{
+		public:
+
+			static constexpr std::uint32_t VERSION = 2;
+
+			/**
+			 *	@brief Write given graph to a binary snapshot file
+			 *
+			 *	@details Throws if graph stars are not well formed, so that written
+			 *			 snapshots can be mapped without checking them again
+			 *
+			 *	@param graph Graph to store
+			 *	@param path Output file path
+			 */
+			static void write(const CSRGraph<V, W>& graph, const std::string& path);
+
+			/**
+			 *	@brief Map a binary snapshot file in memory and use it as graph storage
+			 *
+			 *	@details Mapping is read-only and shared, so processes loading the same
+			 *			 file share a single page cache copy. Header and sections bounds
+			 *			 are always checked, while checking stars takes a pass over
+			 *			 all edges and is only done on request, for files not written
+			 *			 by write or possibly modified since
+			 *
+			 *	@param path Binary graph file path
+			 *	@param validateStars Check that offsets and neighbors of every star are well formed
+			 *	@return std::shared_ptr<CSRGraph<V, W>> Graph backed by the mapped file
+			 */
+			static std::shared_ptr<CSRGraph<V, W>> map(const std::string& path, bool validateStars = false);
+
+			/**
+			 *	@brief Check if given file starts with binary snapshot signature
+			 */
+			static bool isBinaryGraph(const std::string& path);
+
+		private:
+
+			static constexpr char MAGIC[8] = { 'F', 'A', 'S', 'T', 'B', 'C', 'G', '\0' };
+			static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+			static constexpr std::uint64_t ALIGNMENT = 64;
+
+			enum weight_kind_t : std::uint32_t { INTEGRAL = 0, FLOATING = 1 };
+
+			struct header_t
+			{
+				char magic[8];
+				std::uint32_t version;
+				std::uint32_t byteOrder;
+				std::uint32_t vertexBytes;
+				std::uint32_t weightBytes;
+				std::uint32_t weightKind;
+				std::uint32_t offsetBytes;
+				std::uint64_t vertices;
+				std::uint64_t edges;
+				union
+				{
+					double floating;
+					std::int64_t integral;
+				} totalWeight;	// As weight kind, so that integral weights are exact
+				std::uint64_t section[6];
+				std::uint8_t reserved[24];
+			};
+			static_assert(sizeof(header_t) == 128, "Binary graph header must be 128 bytes long");
+
+			static header_t _header(const CSRGraph<V, W>& graph);
+
+			static void _sectionBytes(const header_t& header, std::uint64_t sectionBytes[6]);
+
+			static std::uint64_t _align(std::uint64_t position);
+
+			/**
+			 *	@brief Check that mapped stars are well formed
+			 *
+			 *	@details Offsets must start from zero and never decrease, neighbors
+			 *			 must be valid vertex indices sorted by increasing index
+			 */
+			static bool _validStars(
+				const typename CSRGraph<V, W>::offset_t* offsets,
+				const V* neighbors,
+				std::uint64_t vertices);
+		};
+
+	}
+}
+
+template<typename V, typename W>
+typename fastbc::io::BinaryGraph<V, W>::header_t
+fastbc::io::BinaryGraph<V, W>::_header(const CSRGraph<V, W>& graph)
+{
+	typedef typename CSRGraph<V, W>::offset_t offset_t;
+
+	header_t header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.vertexBytes = sizeof(V);
+	header.weightBytes = sizeof(W);
+	header.weightKind = std::is_floating_point<W>::value ? FLOATING : INTEGRAL;
+	header.offsetBytes = sizeof(offset_t);
+	header.vertices = graph.vertices().size();
+	header.edges = graph.edges();
+	if constexpr (std::is_floating_point<W>::value)
+	{
+		header.totalWeight.floating = (double)graph.totalWeight();
+	}
+	else
+	{
+		header.totalWeight.integral = (std::int64_t)graph.totalWeight();
+	}
+
+	std::uint64_t sectionBytes[6];
+	_sectionBytes(header, sectionBytes);
+
+	std::uint64_t position = _align(sizeof(header_t));
+	for (int s = 0; s < 6; ++s)
+	{
+		header.section[s] = position;
+		position = _align(position + sectionBytes[s]);
+	}
+
+	return header;
+}
+
+template<typename V, typename W>
+void fastbc::io::BinaryGraph<V, W>::_sectionBytes(const header_t& header, std::uint64_t sectionBytes[6])
+{
+	typedef typename CSRGraph<V, W>::offset_t offset_t;
+
+	// Sections sizes: out offsets, targets, weights, in offsets, sources, weights
+	sectionBytes[0] = (header.vertices + 1) * sizeof(offset_t);
+	sectionBytes[1] = header.edges * sizeof(V);
+	sectionBytes[2] = header.edges * sizeof(W);
+	sectionBytes[3] = (header.vertices + 1) * sizeof(offset_t);
+	sectionBytes[4] = header.edges * sizeof(V);
+	sectionBytes[5] = header.edges * sizeof(W);
+}
+
+template<typename V, typename W>
+std::uint64_t fastbc::io::BinaryGraph<V, W>::_align(std::uint64_t position)
+{
+	return (position + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+template<typename V, typename W>
+void fastbc::io::BinaryGraph<V, W>::write(const CSRGraph<V, W>& graph, const std::string& path)
+{
+	if (!_validStars(graph.outOffsets(), graph.outTargets(), graph.vertices().size())
+		|| !_validStars(graph.inOffsets(), graph.inSources(), graph.vertices().size()))
+	{
+		throw std::runtime_error("Graph stars are not well formed");
+	}
+
+	std::ofstream out(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+	if (!out.is_open())
+	{
+		throw std::runtime_error("Unable to open binary graph output file");
+	}
+
+	header_t header = _header(graph);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	const char* sectionData[6] = {
+		reinterpret_cast<const char*>(graph.outOffsets()),
+		reinterpret_cast<const char*>(graph.outTargets()),
+		reinterpret_cast<const char*>(graph.outWeights()),
+		reinterpret_cast<const char*>(graph.inOffsets()),
+		reinterpret_cast<const char*>(graph.inSources()),
+		reinterpret_cast<const char*>(graph.inWeights()) };
+	std::uint64_t sectionBytes[6];
+	_sectionBytes(header, sectionBytes);
+
+	// Write each section padding the file up to its aligned starting position
+	const char padding[ALIGNMENT] = { 0 };
+	std::uint64_t position = sizeof(header);
+	for (int s = 0; s < 6; ++s)
+	{
+		out.write(padding, header.section[s] - position);
+		out.write(sectionData[s], sectionBytes[s]);
+		position = header.section[s] + sectionBytes[s];
+	}
+
+	if (!out)
+	{
+		throw std::runtime_error("Error writing binary graph file");
+	}
+}
+
+template<typename V, typename W>
+std::shared_ptr<fastbc::CSRGraph<V, W>> fastbc::io::BinaryGraph<V, W>::map(const std::string& path, bool validateStars)
+{
+	typedef typename CSRGraph<V, W>::offset_t offset_t;
+
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		throw std::runtime_error("Unable to open binary graph file");
+	}
+
+	struct stat fileStat;
+	if (::fstat(fd, &fileStat) != 0 || (std::uint64_t)fileStat.st_size < sizeof(header_t))
+	{
+		::close(fd);
+		throw std::runtime_error("Binary graph file is truncated");
+	}
+
+	size_t fileSize = fileStat.st_size;
+	void* data = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (data == MAP_FAILED)
+	{
+		throw std::runtime_error("Unable to map binary graph file");
+	}
+
+	// Mapping lifetime is bound to the graph storage handle
+	std::shared_ptr<const void> storage(data, [fileSize](const void* p) {
+		::munmap(const_cast<void*>(p), fileSize);
+	});
+
+	const char* base = static_cast<const char*>(data);
+	const header_t& header = *reinterpret_cast<const header_t*>(base);
+
+	// Validate header against compiled types and file size
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		throw std::runtime_error("Given file is not a binary graph");
+	}
+	if (header.version != VERSION)
+	{
+		throw std::runtime_error("Unsupported binary graph version");
+	}
+	if (header.byteOrder != BYTE_ORDER_MARK)
+	{
+		throw std::runtime_error("Binary graph byte order differs from current architecture");
+	}
+	if (header.vertexBytes != sizeof(V) || header.weightBytes != sizeof(W)
+		|| header.offsetBytes != sizeof(offset_t)
+		|| header.weightKind != (std::is_floating_point<W>::value ? FLOATING : INTEGRAL))
+	{
+		throw std::runtime_error("Binary graph vertex/weight types differ from compiled ones");
+	}
+
+	// Every vertex and edge takes at least a byte, so section sizes cannot overflow
+	if (header.vertices > (std::uint64_t)std::numeric_limits<V>::max()
+		|| header.vertices >= fileSize || header.edges > fileSize)
+	{
+		throw std::runtime_error("Binary graph file is truncated or corrupted");
+	}
+
+	std::uint64_t sectionBytes[6];
+	_sectionBytes(header, sectionBytes);
+	for (int s = 0; s < 6; ++s)
+	{
+		if (header.section[s] % ALIGNMENT != 0 || header.section[s] > fileSize
+			|| sectionBytes[s] > fileSize - header.section[s])
+		{
+			throw std::runtime_error("Binary graph file is truncated or corrupted");
+		}
+	}
+
+	const offset_t* outOffsets = reinterpret_cast<const offset_t*>(base + header.section[0]);
+	const offset_t* inOffsets = reinterpret_cast<const offset_t*>(base + header.section[3]);
+	if (outOffsets[0] != 0 || inOffsets[0] != 0
+		|| outOffsets[header.vertices] != header.edges || inOffsets[header.vertices] != header.edges)
+	{
+		throw std::runtime_error("Binary graph offsets are inconsistent with edges count");
+	}
+
+	// Corrupted stars would cause out of bounds accesses later on
+	if (validateStars
+		&& (!_validStars(outOffsets, reinterpret_cast<const V*>(base + header.section[1]), header.vertices)
+		|| !_validStars(inOffsets, reinterpret_cast<const V*>(base + header.section[4]), header.vertices)))
+	{
+		throw std::runtime_error("Binary graph stars are corrupted");
+	}
+
+	W totalWeight;
+	if constexpr (std::is_floating_point<W>::value)
+	{
+		totalWeight = (W)header.totalWeight.floating;
+	}
+	else
+	{
+		totalWeight = (W)header.totalWeight.integral;
+	}
+
+	return std::make_shared<CSRGraph<V, W>>(
+		(V)header.vertices,
+		totalWeight,
+		outOffsets,
+		reinterpret_cast<const V*>(base + header.section[1]),
+		reinterpret_cast<const W*>(base + header.section[2]),
+		inOffsets,
+		reinterpret_cast<const V*>(base + header.section[4]),
+		reinterpret_cast<const W*>(base + header.section[5]),
+		storage);
+}
+
+template<typename V, typename W>
+bool fastbc::io::BinaryGraph<V, W>::_validStars(
+	const typename CSRGraph<V, W>::offset_t* offsets,
+	const V* neighbors,
+	std::uint64_t vertices)
+{
+	if (vertices > (std::uint64_t)std::numeric_limits<V>::max() || offsets[0] != 0)
+	{
+		return false;
+	}
+
+	bool valid = true;
+	#pragma omp parallel for schedule(dynamic, 1024) reduction(&&:valid)
+	for (std::uint64_t v = 0; v < vertices; ++v)
+	{
+		// Skip stars whose bounds are already known to be invalid
+		if (offsets[v] > offsets[v + 1] || offsets[v + 1] > offsets[vertices])
+		{
+			valid = false;
+			continue;
+		}
+
+		for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+		{
+			valid = valid && neighbors[e] >= 0 && (std::uint64_t)neighbors[e] < vertices
+				&& (e == offsets[v] || neighbors[e - 1] < neighbors[e]);
+		}
+	}
+
+	return valid;
+}
+
+template<typename V, typename W>
+bool fastbc::io::BinaryGraph<V, W>::isBinaryGraph(const std::string& path)
+{
+	std::ifstream in(path, std::ifstream::in | std::ifstream::binary);
+	char magic[sizeof(MAGIC)];
+
+	if (!in.read(magic, sizeof(magic)))
+	{
+		return false;
+	}
+
+	return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+#endif
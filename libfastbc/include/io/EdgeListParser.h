@@ -0,0 +1,412 @@
+#ifndef FASTBC_IO_EDGELISTPARSER_H
+#define FASTBC_IO_EDGELISTPARSER_H
+
+#include <CSRGraph.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <omp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fastbc {
+	namespace io {
+
+		/**
+		 *	@brief Parallel text edge list parser building CSR graphs
+		 *
+		 *	@details Input is split on line boundaries in one chunk per thread and each
+		 *			 chunk is parsed with std::from_chars into a per-thread edge buffer.
+		 *			 Buffers are then merged in a single sort/dedup pass that sums the
+		 *			 weights of duplicated edges in file order.
+		 *
+		 *	@tparam V Type for vertex index number
+		 *	@tparam W Type for edge weight value
+		 */
+		template<typename V, typename W>
+		class EdgeListParser
+		{
+		public:
+
+			/**
+			 *	@brief Parse given edge list file
+			 *
+			 *	@details Each line of the file should feed edges information like:
+			 *			 <src_index> <dest_index> <edge_weight>
+			 *
+			 *	@param path Edge list file path
+			 *	@return std::shared_ptr<CSRGraph<V, W>> Parsed graph
+			 */
+			static std::shared_ptr<CSRGraph<V, W>> parse(const std::string& path);
+
+			/**
+			 *	@brief Parse edge list text stored in [begin, end) memory range
+			 */
+			static std::shared_ptr<CSRGraph<V, W>> parse(const char* begin, const char* end);
+
+		private:
+			typedef typename CSRGraph<V, W>::offset_t offset_t;
+
+			struct edge_t
+			{
+				V src;
+				V dest;
+				W weight;
+			};
+
+			enum parse_status_t { PARSE_OK, PARSE_MALFORMED, PARSE_INVALID };
+
+			static const char* _lineStart(const char* begin, const char* end, const char* position);
+
+			// Skip whitespaces, empty lines included
+			static const char* _skipSpaces(const char* position, const char* end);
+
+			// Skip field separators (spaces and tabs) inside a line
+			static const char* _skipBlanks(const char* position, const char* end);
+
+			static parse_status_t _parseChunk(const char* begin, const char* end, std::vector<edge_t>& edges);
+
+			static std::shared_ptr<CSRGraph<V, W>> _build(std::vector<edge_t>&& edges);
+		};
+
+	}
+}
+
+template<typename V, typename W>
+std::shared_ptr<fastbc::CSRGraph<V, W>> fastbc::io::EdgeListParser<V, W>::parse(const std::string& path)
+{
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		throw std::runtime_error("There was an error opening given edge list file path.");
+	}
+
+	struct stat fileStat;
+	if (::fstat(fd, &fileStat) != 0)
+	{
+		::close(fd);
+		throw std::runtime_error("Unable to read edge list file size");
+	}
+
+	size_t fileSize = fileStat.st_size;
+	if (fileSize == 0)
+	{
+		::close(fd);
+		return parse(nullptr, nullptr);
+	}
+
+	void* data = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+
+	if (data == MAP_FAILED)
+	{
+		throw std::runtime_error("Unable to map edge list file");
+	}
+
+	::madvise(data, fileSize, MADV_SEQUENTIAL);
+
+	std::shared_ptr<CSRGraph<V, W>> graph;
+	try {
+		const char* text = static_cast<const char*>(data);
+		graph = parse(text, text + fileSize);
+	}
+	catch (...)
+	{
+		::munmap(data, fileSize);
+		throw;
+	}
+
+	::munmap(data, fileSize);
+	return graph;
+}
+
+template<typename V, typename W>
+std::shared_ptr<fastbc::CSRGraph<V, W>> fastbc::io::EdgeListParser<V, W>::parse(const char* begin, const char* end)
+{
+	std::vector<std::vector<edge_t>> threadEdges;
+	std::vector<parse_status_t> threadStatus;
+
+	#pragma omp parallel
+	{
+		#pragma omp single
+		{
+			threadEdges.resize(omp_get_num_threads());
+			threadStatus.resize(omp_get_num_threads(), PARSE_OK);
+		}
+
+		// Each thread parses a chunk of whole lines
+		size_t t = omp_get_thread_num();
+		size_t chunks = omp_get_num_threads();
+		size_t size = end - begin;
+		const char* chunkBegin = _lineStart(begin, end, begin + size * t / chunks);
+		const char* chunkEnd = _lineStart(begin, end, begin + size * (t + 1) / chunks);
+
+		threadStatus[t] = _parseChunk(chunkBegin, chunkEnd, threadEdges[t]);
+	}
+
+	for (const auto& status : threadStatus)
+	{
+		if (status == PARSE_INVALID)
+		{
+			throw std::invalid_argument("Edge weight must be greater than zero");
+		}
+		if (status == PARSE_MALFORMED)
+		{
+			throw std::invalid_argument("Malformed edge list");
+		}
+	}
+
+	// Concatenate thread buffers preserving file order
+	std::vector<size_t> threadOffset(threadEdges.size() + 1, 0);
+	for (size_t t = 0; t < threadEdges.size(); ++t)
+	{
+		threadOffset[t + 1] = threadOffset[t] + threadEdges[t].size();
+	}
+
+	std::vector<edge_t> edges(threadOffset.back());
+	#pragma omp parallel for
+	for (size_t t = 0; t < threadEdges.size(); ++t)
+	{
+		std::copy(threadEdges[t].begin(), threadEdges[t].end(), edges.begin() + threadOffset[t]);
+		std::vector<edge_t>().swap(threadEdges[t]);
+	}
+
+	return _build(std::move(edges));
+}
+
+template<typename V, typename W>
+const char* fastbc::io::EdgeListParser<V, W>::_lineStart(const char* begin, const char* end, const char* position)
+{
+	if (position <= begin) { return begin; }
+	if (position >= end) { return end; }
+
+	// First line starting at or after given position
+	const char* newLine = std::find(position - 1, end, '\n');
+	return newLine == end ? end : newLine + 1;
+}
+
+template<typename V, typename W>
+const char* fastbc::io::EdgeListParser<V, W>::_skipSpaces(const char* position, const char* end)
+{
+	while (position < end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+	{
+		++position;
+	}
+
+	return position;
+}
+
+template<typename V, typename W>
+const char* fastbc::io::EdgeListParser<V, W>::_skipBlanks(const char* position, const char* end)
+{
+	while (position < end && (*position == ' ' || *position == '\t'))
+	{
+		++position;
+	}
+
+	return position;
+}
+
+template<typename V, typename W>
+typename fastbc::io::EdgeListParser<V, W>::parse_status_t
+fastbc::io::EdgeListParser<V, W>::_parseChunk(const char* begin, const char* end, std::vector<edge_t>& edges)
+{
+	const char* p = _skipSpaces(begin, end);
+
+	while (p < end)
+	{
+		edge_t e;
+
+		// Fields of a line are separated by spaces or tabs only, so that a
+		// missing field is never taken from the next line
+		auto src = std::from_chars(p, end, e.src);
+		if (src.ec != std::errc() || _skipBlanks(src.ptr, end) == src.ptr) { return PARSE_MALFORMED; }
+		p = _skipBlanks(src.ptr, end);
+
+		auto dest = std::from_chars(p, end, e.dest);
+		if (dest.ec != std::errc() || _skipBlanks(dest.ptr, end) == dest.ptr) { return PARSE_MALFORMED; }
+		p = _skipBlanks(dest.ptr, end);
+
+		auto weight = std::from_chars(p, end, e.weight);
+		if (weight.ec != std::errc()) { return PARSE_MALFORMED; }
+		p = _skipBlanks(weight.ptr, end);
+
+		// Weight must end the line
+		if (p < end && *p == '\r') { ++p; }
+		if (p < end && *p != '\n') { return PARSE_MALFORMED; }
+		p = _skipSpaces(p, end);
+
+		if (e.src < 0 || e.dest < 0) { return PARSE_MALFORMED; }
+		if (e.weight <= 0) { return PARSE_INVALID; }
+
+		edges.push_back(e);
+	}
+
+	return PARSE_OK;
+}
+
+template<typename V, typename W>
+std::shared_ptr<fastbc::CSRGraph<V, W>> fastbc::io::EdgeListParser<V, W>::_build(std::vector<edge_t>&& edges)
+{
+	// Graph vertices are 0..max index
+	V maxVertex = 0;
+	#pragma omp parallel for reduction(max:maxVertex)
+	for (size_t e = 0; e < edges.size(); ++e)
+	{
+		maxVertex = std::max(maxVertex, std::max(edges[e].src, edges[e].dest));
+	}
+	size_t vertexCount = edges.empty() ? 0 : (size_t)maxVertex + 1;
+
+	// Bucket edge indices by source vertex
+	std::vector<offset_t> rowStart(vertexCount + 1, 0);
+	#pragma omp parallel for
+	for (size_t e = 0; e < edges.size(); ++e)
+	{
+		#pragma omp atomic
+		rowStart[edges[e].src + 1]++;
+	}
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		rowStart[v + 1] += rowStart[v];
+	}
+
+	std::vector<size_t> order(edges.size());
+	{
+		std::vector<offset_t> rowFill(rowStart.begin(), rowStart.end() - 1);
+		#pragma omp parallel for
+		for (size_t e = 0; e < edges.size(); ++e)
+		{
+			offset_t position;
+			#pragma omp atomic capture
+			position = rowFill[edges[e].src]++;
+
+			order[position] = e;
+		}
+	}
+
+	// Sort each row by destination and file position, then count distinct edges
+	std::vector<offset_t> outOffsets(vertexCount + 1, 0);
+	#pragma omp parallel for schedule(dynamic, 1024)
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		std::sort(order.begin() + rowStart[v], order.begin() + rowStart[v + 1],
+			[&edges](size_t lhs, size_t rhs) {
+				if (edges[lhs].dest == edges[rhs].dest)
+					return lhs < rhs;
+				return edges[lhs].dest < edges[rhs].dest;
+			});
+
+		offset_t distinct = 0;
+		for (offset_t i = rowStart[v]; i < rowStart[v + 1]; ++i)
+		{
+			if (i == rowStart[v] || edges[order[i]].dest != edges[order[i - 1]].dest)
+			{
+				++distinct;
+			}
+		}
+		outOffsets[v + 1] = distinct;
+	}
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		outOffsets[v + 1] += outOffsets[v];
+	}
+
+	// Store forward stars summing duplicated edges weight in file order
+	std::vector<V> outTargets(outOffsets.back());
+	std::vector<W> outWeights(outOffsets.back());
+	#pragma omp parallel for schedule(dynamic, 1024)
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		offset_t out = outOffsets[v];
+		for (offset_t i = rowStart[v]; i < rowStart[v + 1]; ++i)
+		{
+			const edge_t& e = edges[order[i]];
+			if (i == rowStart[v] || e.dest != edges[order[i - 1]].dest)
+			{
+				outTargets[out] = e.dest;
+				outWeights[out] = e.weight;
+				++out;
+			}
+			else
+			{
+				outWeights[out - 1] += e.weight;
+			}
+		}
+	}
+
+	std::vector<edge_t>().swap(edges);
+	std::vector<size_t>().swap(order);
+	std::vector<offset_t>().swap(rowStart);
+
+	// Transpose forward stars to get backward stars
+	std::vector<offset_t> inOffsets(vertexCount + 1, 0);
+	#pragma omp parallel for
+	for (size_t e = 0; e < outTargets.size(); ++e)
+	{
+		#pragma omp atomic
+		inOffsets[outTargets[e] + 1]++;
+	}
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		inOffsets[v + 1] += inOffsets[v];
+	}
+
+	std::vector<V> inSources(inOffsets.back());
+	std::vector<W> inWeights(inOffsets.back());
+	{
+		std::vector<offset_t> rowFill(inOffsets.begin(), inOffsets.end() - 1);
+		#pragma omp parallel for schedule(dynamic, 1024)
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			for (offset_t e = outOffsets[v]; e < outOffsets[v + 1]; ++e)
+			{
+				offset_t position;
+				#pragma omp atomic capture
+				position = rowFill[outTargets[e]]++;
+
+				inSources[position] = v;
+				inWeights[position] = outWeights[e];
+			}
+		}
+	}
+
+	// Restore backward stars ordering by source vertex
+	#pragma omp parallel
+	{
+		std::vector<std::pair<V, W>> star;
+
+		#pragma omp for schedule(dynamic, 1024)
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			star.clear();
+			for (offset_t e = inOffsets[v]; e < inOffsets[v + 1]; ++e)
+			{
+				star.emplace_back(inSources[e], inWeights[e]);
+			}
+
+			std::sort(star.begin(), star.end(),
+				[](const std::pair<V, W>& lhs, const std::pair<V, W>& rhs) { return lhs.first < rhs.first; });
+
+			for (size_t i = 0; i < star.size(); ++i)
+			{
+				inSources[inOffsets[v] + i] = star[i].first;
+				inWeights[inOffsets[v] + i] = star[i].second;
+			}
+		}
+	}
+
+	return std::make_shared<CSRGraph<V, W>>(
+		std::move(outOffsets), std::move(outTargets), std::move(outWeights),
+		std::move(inOffsets), std::move(inSources), std::move(inWeights));
+}
+
+#endif
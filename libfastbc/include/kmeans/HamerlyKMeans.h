@@ -0,0 +1,292 @@
+#ifndef FASTBC_KMEANS_HAMERLYKMEANS_H
+#define FASTBC_KMEANS_HAMERLYKMEANS_H
+
+#include "PlusPlusKMeans.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace fastbc {
+	namespace kmeans {
+
+		/**
+		 *	@brief K-means accelerated by Hamerly's distance bounds
+		 *
+		 *	@details Same initialization strategies, centroid update (nearest vertex to cluster mean)
+		 *			 and stop condition of PlusPlusKMeans. Each vertex keeps an upper bound
+		 *			 of the euclidean distance to its centroid and a lower bound of the
+		 *			 distance to any other centroid; bounds are updated with the distance
+		 *			 each centroid moved, and centroids are scanned only for the vertices
+		 *			 whose bounds overlap. After the first iterations most vertices are
+		 *			 assigned without computing any distance.
+		 *			 Bounds and assignments are kept in flat arrays indexed by vertex.
+		 */
+		template<typename V, typename W>
+		class HamerlyKMeans : public PlusPlusKMeans<V, W>
+		{
+		public:
+			using PlusPlusKMeans<V, W>::PlusPlusKMeans;
+
+			std::pair<std::vector<V>, std::vector<V>> computeCentroids(
+				int k,
+				const std::vector<V>& vertices,
+				const std::vector<V>& weights,
+				const brandes::VertexInfoMatrix<V, W>& vertexInfo,
+				W minVariance = 0,
+				size_t maxIteration = 100) override;
+
+		private:
+
+			/**
+			 *	@brief Vertices assigned by each task
+			 */
+			static constexpr size_t VERTEX_GRAIN = 256;
+
+			/**
+			 *	@brief Centroids updated by each task
+			 */
+			static constexpr size_t CENTROID_GRAIN = 16;
+		};
+
+	}
+}
+
+template<typename V, typename W>
+std::pair<std::vector<V>, std::vector<V>>
+fastbc::kmeans::HamerlyKMeans<V, W>::computeCentroids(
+	int k,
+	const std::vector<V>& vertices,
+	const std::vector<V>& weights,
+	const brandes::VertexInfoMatrix<V, W>& vertexInfo,
+	W minVariance,
+	size_t maxIteration)
+{
+	size_t vertexCount = vertices.size();
+
+	// Current centroids vector
+	std::vector<V> newCentroid = this->_init(k, vertices, vertexInfo);
+	std::vector<V> centroid(newCentroid.size());
+	size_t centroidCount = centroid.size();
+
+	// Assigned centroid of each vertex, upper bound of the distance from it and
+	// lower bound of the distance from any other centroid. Initial bounds force a first scan
+	std::vector<V> assigned(vertexCount, 0);
+	std::vector<W> upper(vertexCount, std::numeric_limits<W>::max());
+	std::vector<W> lower(vertexCount, 0);
+
+	// Initialization can select a vertex more than once: centroids sharing the assigned
+	// one position (twins) are left out of the lower bound, they are never nearer and
+	// stay empty until the assigned centroid moves
+	std::vector<char> twin(vertexCount, 0);
+
+	// Distance covered by each centroid in last update
+	std::vector<W> drift(centroidCount, 0);
+
+	// Half distance from each centroid to the nearest other one: a vertex closer than
+	// that to its centroid cannot be nearer to any other centroid
+	std::vector<W> halfGap(centroidCount, 0);
+
+	// Vertices of each centroid, grouped by assigned centroid in vertex order
+	std::vector<size_t> memberOffset(centroidCount + 1);
+	std::vector<size_t> member(vertexCount);
+
+	// Mean of each centroid vertices
+	brandes::VertexInfoMatrix<W, W> mean(centroidCount, vertexInfo.borders());
+
+	// Relative margin between bounds. Vertex info is often made of integers, so equal
+	// distances are common and rounding must not make a tie look like a strict bound
+	const W boundMargin = 1 + std::sqrt(std::numeric_limits<W>::epsilon());
+
+	size_t iteration = 0;
+	do {
+		++iteration;
+		centroid = newCentroid;
+
+		// Largest drifts, the lower bound of a vertex is moved by the largest other centroid drift
+		W maxDrift = 0, secondDrift = 0;
+		V maxDriftCentroid = 0;
+		for (size_t c = 0; c < centroidCount; ++c)
+		{
+			if (drift[c] > maxDrift)
+			{
+				secondDrift = maxDrift;
+				maxDrift = drift[c];
+				maxDriftCentroid = (V)c;
+			}
+			else if (drift[c] > secondDrift)
+			{
+				secondDrift = drift[c];
+			}
+		}
+
+		#pragma omp taskloop grainsize(CENTROID_GRAIN) shared(vertexInfo, centroid, halfGap)
+		for (size_t c = 0; c < centroidCount; ++c)
+		{
+			const auto cVI = vertexInfo.row(centroid[c]);
+			W minDist = std::numeric_limits<W>::max();
+			for (size_t o = 0; o < centroidCount; ++o)
+			{
+				if (o != c)
+				{
+					minDist = std::min(minDist, vertexInfo.row(centroid[o]).squaredDistance(cVI));
+				}
+			}
+
+			halfGap[c] = minDist < std::numeric_limits<W>::max() ?
+				std::sqrt(minDist) / 2 : std::numeric_limits<W>::max();
+		}
+
+		// Associate each vertex to nearest cluster
+		#pragma omp taskloop grainsize(VERTEX_GRAIN) shared(vertices, vertexInfo, centroid, assigned, upper, lower, twin, drift, halfGap, boundMargin)
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			V a = assigned[v];
+			upper[v] += drift[a];
+			lower[v] -= (a == maxDriftCentroid) ? secondDrift : maxDrift;
+
+			// Bounds prove assigned centroid is still the nearest
+			bool twinLeft = twin[v] && drift[a] > 0;
+			W bound = std::max(lower[v], halfGap[a]);
+			if (!twinLeft && upper[v] * boundMargin < bound)
+			{
+				continue;
+			}
+
+			// Tighten upper bound and try again
+			const auto vVI = vertexInfo.row(vertices[v]);
+			upper[v] = std::sqrt(vertexInfo.row(centroid[a]).squaredDistance(vVI));
+			if (!twinLeft && upper[v] * boundMargin < bound)
+			{
+				continue;
+			}
+
+			// Select nearest and second nearest cluster to current vertex, ties go to
+			// the lowest centroid index so twins of the nearest one always follow it
+			W minDist = vertexInfo.row(centroid[0]).squaredDistance(vVI);
+			W secondDist = std::numeric_limits<W>::max();
+			V minC = 0;
+			twin[v] = 0;
+			for (size_t c = 1; c < centroidCount; ++c)
+			{
+				if (centroid[c] == centroid[minC])
+				{
+					twin[v] = 1;
+					continue;
+				}
+
+				W dist = vertexInfo.row(centroid[c]).squaredDistance(vVI);
+
+				if (dist < minDist)
+				{
+					secondDist = minDist;
+					minDist = dist;
+					minC = c;
+					twin[v] = 0;
+				}
+				else if (dist < secondDist)
+				{
+					secondDist = dist;
+				}
+			}
+
+			assigned[v] = minC;
+			upper[v] = std::sqrt(minDist);
+			lower[v] = secondDist < std::numeric_limits<W>::max() ?
+				std::sqrt(secondDist) : std::numeric_limits<W>::max();
+		}
+
+		// Group vertices by assigned centroid
+		std::fill(memberOffset.begin(), memberOffset.end(), 0);
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			++memberOffset[assigned[v] + 1];
+		}
+		for (size_t c = 0; c < centroidCount; ++c)
+		{
+			memberOffset[c + 1] += memberOffset[c];
+		}
+		{
+			std::vector<size_t> cursor(memberOffset.begin(), memberOffset.end() - 1);
+			for (size_t v = 0; v < vertexCount; ++v)
+			{
+				member[cursor[assigned[v]]++] = v;
+			}
+		}
+
+		// Choose new centroids for each computed cluster
+		#pragma omp taskloop grainsize(CENTROID_GRAIN) shared(vertices, vertexInfo, centroid, newCentroid, drift, memberOffset, member, mean)
+		for (size_t c = 0; c < centroidCount; ++c)
+		{
+			size_t begin = memberOffset[c], end = memberOffset[c + 1];
+			if (begin == end)
+			{
+				drift[c] = 0;
+				continue;
+			}
+
+			auto cMean = mean.row(c);
+			W* meanLength = cMean.lengths();
+			W* meanCount = cMean.counts();
+			cMean.reset();
+
+			for (size_t m = begin; m < end; ++m)
+			{
+				const auto mVI = vertexInfo.row(vertices[member[m]]);
+				const W* length = mVI.lengths();
+				const V* count = mVI.counts();
+
+				#pragma omp simd
+				for (int b = 0; b < cMean.borders(); ++b)
+				{
+					meanLength[b] += length[b];
+					meanCount[b] += count[b];
+				}
+			}
+
+			W size = end - begin;
+
+			#pragma omp simd
+			for (int b = 0; b < cMean.borders(); ++b)
+			{
+				meanLength[b] /= size;
+				meanCount[b] /= size;
+			}
+
+			// New centroid will be the nearest existing vertex to computed centroid
+			size_t nearest = member[begin];
+			W nearestDist = cMean.squaredDistance(vertexInfo.row(vertices[nearest]));
+			for (size_t m = begin + 1; m < end; ++m)
+			{
+				W dist = cMean.squaredDistance(vertexInfo.row(vertices[member[m]]));
+
+				if (dist < nearestDist)
+				{
+					nearest = member[m];
+					nearestDist = dist;
+				}
+			}
+
+			newCentroid[c] = vertices[nearest];
+			drift[c] = std::sqrt(vertexInfo.row(centroid[c]).squaredDistance(vertexInfo.row(newCentroid[c])));
+		}
+
+	// Iterate until no significant change in centroids is detected or max iteration is reached
+	} while (this->_centroidVariance(centroid, newCentroid, vertexInfo) > minVariance
+		&& iteration <= maxIteration);
+
+	std::pair<std::vector<V>, std::vector<V>> centroidWeights =
+		std::make_pair(centroid, std::vector<V>(centroidCount, 0));
+
+	// Compute each centroid final weight
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		centroidWeights.second[assigned[v]] += weights[v];
+	}
+
+	return centroidWeights;
+}
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef FASTBC_KMEANS_MINIBATCHKMEANS_H
+#define FASTBC_KMEANS_MINIBATCHKMEANS_H
+
+#include "PlusPlusKMeans.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace fastbc {
+	namespace kmeans {
+
+		/**
+		 *	@brief Mini-batch k-means
+		 *
+		 *	@details Each iteration assigns a batch of vertices, sampled proportionally
+		 *			 to their weight, to the nearest centroid and moves every assigned
+		 *			 centroid towards its batch vertices with a per-centroid learning rate.
+		 *			 Initialization runs a PlusPlusKMeans strategy on a random sample.
+		 *			 Centroids are continuous while iterating; a final pass assigns every
+		 *			 vertex and replaces each centroid with its nearest member, so results
+		 *			 are vertex rows as for the other implementations.
+		 *			 Time and memory of the iterations only depend on batch size and k,
+		 *			 while the final pass is a single full assignment. The final inertia
+		 *			 (weighted squared distance of vertices from their centroid) is logged
+		 *			 at info level.
+		 */
+		template<typename V, typename W>
+		class MiniBatchKMeans : public PlusPlusKMeans<V, W>
+		{
+		public:
+
+			/**
+			 *	@brief Initialize a mini-batch kmeans
+			 *
+			 *	@param batchSize Number of vertices sampled at each iteration
+			 *	@param seed Seed of the random generator used for sampling
+			 *	@param initialization Initial centroids selection strategy
+			 */
+			MiniBatchKMeans(
+				size_t batchSize,
+				unsigned int seed = 0,
+				typename PlusPlusKMeans<V, W>::Initialization initialization =
+					PlusPlusKMeans<V, W>::Initialization::PLUSPLUS);
+
+			std::pair<std::vector<V>, std::vector<V>> computeCentroids(
+				int k,
+				const std::vector<V>& vertices,
+				const std::vector<V>& weights,
+				const brandes::VertexInfoMatrix<V, W>& vertexInfo,
+				W minVariance = 0,
+				size_t maxIteration = 100) override;
+
+			/**
+			 *	@brief Log, at info level, vertices, iterations and inertia summed over
+			 *		   calls since last one, then reset them
+			 */
+			void logSummary() override;
+
+		private:
+
+			/**
+			 *	@brief Vertices assigned by each task
+			 */
+			static constexpr size_t VERTEX_GRAIN = 256;
+
+			// Nearest centroid to given vertex info, ties go to the lowest index
+			template<typename N, typename E>
+			static std::pair<size_t, W> _nearest(
+				const brandes::VertexInfoMatrix<W, W>& centroidInfo,
+				const brandes::VertexInfoView<N, E>& vi);
+
+			const size_t _batchSize;
+			const unsigned int _seed;
+
+			// Summary of calls since last logSummary call, updated atomically
+			size_t _runs = 0;
+			size_t _vertices = 0;
+			size_t _iterations = 0;
+			double _inertia = 0;
+		};
+
+	}
+}
+
+template<typename V, typename W>
+fastbc::kmeans::MiniBatchKMeans<V, W>::MiniBatchKMeans(
+	size_t batchSize,
+	unsigned int seed,
+	typename PlusPlusKMeans<V, W>::Initialization initialization)
+	: PlusPlusKMeans<V, W>(initialization, seed), _batchSize(batchSize), _seed(seed)
+{
+	if (_batchSize == 0)
+	{
+		throw std::invalid_argument("Mini-batch size must be greater than zero");
+	}
+}
+
+template<typename V, typename W>
+std::pair<std::vector<V>, std::vector<V>>
+fastbc::kmeans::MiniBatchKMeans<V, W>::computeCentroids(
+	int k,
+	const std::vector<V>& vertices,
+	const std::vector<V>& weights,
+	const brandes::VertexInfoMatrix<V, W>& vertexInfo,
+	W minVariance,
+	size_t maxIteration)
+{
+	size_t vertexCount = vertices.size();
+	if (vertexCount == 0)
+	{
+		return std::make_pair(std::vector<V>(), std::vector<V>());
+	}
+
+	std::mt19937 generator(_seed);
+
+	// Initial centroids from a sample large enough to hold k vertices
+	std::vector<V> sample;
+	sample.reserve(std::min(vertexCount, std::max(_batchSize, (size_t)k)));
+	std::sample(vertices.begin(), vertices.end(), std::back_inserter(sample),
+		sample.capacity(), generator);
+
+	std::vector<V> initCentroid = this->_init(k, sample, vertexInfo);
+	size_t centroidCount = initCentroid.size();
+
+	// Continuous centroids and number of vertices each one has been moved towards
+	brandes::VertexInfoMatrix<W, W> centroidInfo(centroidCount, vertexInfo.borders());
+	brandes::VertexInfoMatrix<W, W> previousInfo;
+	std::vector<size_t> centroidHits(centroidCount, 0);
+	for (size_t c = 0; c < centroidCount; ++c)
+	{
+		const auto cVI = vertexInfo.row(initCentroid[c]);
+		for (int b = 0; b < cVI.borders(); ++b)
+		{
+			centroidInfo.row(c).setBorderSPLength(b, cVI.getBorderSPLength(b));
+			centroidInfo.row(c).setBorderSPCount(b, cVI.getBorderSPCount(b));
+		}
+	}
+
+	// Weighted vertices are sampled as many times as their weight
+	std::discrete_distribution<size_t> vertexSampler(weights.begin(), weights.end());
+	size_t batchSize = std::min(_batchSize, vertexCount);
+	std::vector<size_t> batch(batchSize);
+	std::vector<size_t> batchCentroid(batchSize);
+
+	size_t iteration = 0;
+	W variance = std::numeric_limits<W>::max();
+	while (variance > minVariance && iteration < maxIteration)
+	{
+		++iteration;
+		previousInfo = centroidInfo;
+
+		for (auto& v : batch)
+		{
+			v = vertexSampler(generator);
+		}
+
+		// Associate each batch vertex to nearest centroid
+		#pragma omp taskloop grainsize(VERTEX_GRAIN) shared(vertices, vertexInfo, centroidInfo, batch, batchCentroid)
+		for (size_t i = 0; i < batchSize; ++i)
+		{
+			batchCentroid[i] = _nearest(centroidInfo, vertexInfo.row(vertices[batch[i]])).first;
+		}
+
+		// Move centroids towards their batch vertices, each vertex counts as much as
+		// all the vertices previously assigned to the same centroid
+		for (size_t i = 0; i < batchSize; ++i)
+		{
+			size_t c = batchCentroid[i];
+			W rate = (W)1 / ++centroidHits[c];
+
+			const auto vVI = vertexInfo.row(vertices[batch[i]]);
+			const W* length = vVI.lengths();
+			const V* count = vVI.counts();
+			auto cVI = centroidInfo.row(c);
+			W* cLength = cVI.lengths();
+			W* cCount = cVI.counts();
+
+			#pragma omp simd
+			for (int b = 0; b < cVI.borders(); ++b)
+			{
+				cLength[b] += (length[b] - cLength[b]) * rate;
+				cCount[b] += (count[b] - cCount[b]) * rate;
+			}
+		}
+
+		variance = 0;
+		for (size_t c = 0; c < centroidCount; ++c)
+		{
+			variance = std::max(variance, centroidInfo.row(c).squaredDistance(previousInfo.row(c)));
+		}
+	}
+
+	// Associate every vertex to nearest centroid
+	std::vector<size_t> assigned(vertexCount);
+	std::vector<W> distance(vertexCount);
+	#pragma omp taskloop grainsize(VERTEX_GRAIN) shared(vertices, vertexInfo, centroidInfo, assigned, distance)
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		std::tie(assigned[v], distance[v]) = _nearest(centroidInfo, vertexInfo.row(vertices[v]));
+	}
+
+	// Centroids become the nearest member vertex, empty ones keep their initial vertex
+	std::pair<std::vector<V>, std::vector<V>> centroidWeights =
+		std::make_pair(initCentroid, std::vector<V>(centroidCount, 0));
+	std::vector<W> nearestDist(centroidCount, std::numeric_limits<W>::max());
+	double inertia = 0;
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		size_t c = assigned[v];
+		centroidWeights.second[c] += weights[v];
+		inertia += (double)weights[v] * distance[v];
+
+		if (distance[v] < nearestDist[c])
+		{
+			nearestDist[c] = distance[v];
+			centroidWeights.first[c] = vertices[v];
+		}
+	}
+
+	#pragma omp atomic
+	++_runs;
+	#pragma omp atomic
+	_vertices += vertexCount;
+	#pragma omp atomic
+	_iterations += iteration;
+	#pragma omp atomic
+	_inertia += inertia;
+
+	return centroidWeights;
+}
+
+template<typename V, typename W>
+void fastbc::kmeans::MiniBatchKMeans<V, W>::logSummary()
+{
+	SPDLOG_INFO("Mini-batch kmeans: {} vertices over {} calls, {} iterations, inertia {}",
+		_vertices, _runs, _iterations, _inertia);
+
+	_runs = 0;
+	_vertices = 0;
+	_iterations = 0;
+	_inertia = 0;
+}
+
+template<typename V, typename W>
+template<typename N, typename E>
+std::pair<size_t, W> fastbc::kmeans::MiniBatchKMeans<V, W>::_nearest(
+	const brandes::VertexInfoMatrix<W, W>& centroidInfo,
+	const brandes::VertexInfoView<N, E>& vi)
+{
+	size_t minC = 0;
+	W minDist = centroidInfo.row(0).squaredDistance(vi);
+	for (size_t c = 1; c < centroidInfo.rows(); ++c)
+	{
+		W dist = centroidInfo.row(c).squaredDistance(vi);
+
+		if (dist < minDist)
+		{
+			minC = c;
+			minDist = dist;
+		}
+	}
+
+	return std::make_pair(minC, minDist);
+}
+
+#endif
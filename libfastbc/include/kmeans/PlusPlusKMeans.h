@@ -2,6 +2,12 @@
 #define FASTBC_KMEANS_PLUSPLUSKMEANS_H
 
 #include "IKMeans.h"
+#include <brandes/VertexInfo.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
 
 namespace fastbc {
 	namespace kmeans {
@@ -10,25 +16,90 @@ namespace fastbc {
 		class PlusPlusKMeans : public IKMeans<V, W>
 		{
 		public:
+
+			/**
+			 *	@brief Initial centroids selection strategy
+			 *
+			 *	@details PLUSPLUS picks each centroid sequentially as the vertex farthest
+			 *			 on average from the previous ones, with a pass over all vertices
+			 *			 for each centroid. PARALLEL is k-means|| seeding: a few parallel
+			 *			 rounds oversample candidates proportionally to their squared
+			 *			 distance from the current ones, then candidates weighted by their
+			 *			 nearest vertices are reduced to k centroids with k-means++. When
+			 *			 sampling ends with no more than k candidates, as vertices with
+			 *			 equal info are never sampled twice, each one is a centroid and
+			 *			 fewer than k centroids are computed.
+			 */
+			enum class Initialization { PLUSPLUS, PARALLEL };
+
+			/**
+			 *	@brief Initialize a kmeans computer
+			 *
+			 *	@param initialization Initial centroids selection strategy
+			 *	@param seed Seed of random choices made by PARALLEL initialization
+			 */
+			PlusPlusKMeans(Initialization initialization = Initialization::PLUSPLUS, unsigned int seed = 0);
+
 			std::pair<std::vector<V>, std::vector<V>> computeCentroids(
 				int k,
 				const std::vector<V>& vertices,
 				const std::vector<V>& weights,
-				const std::vector<std::shared_ptr<brandes::VertexInfo<V, W>>>& vertexInfo,
+				const brandes::VertexInfoMatrix<V, W>& vertexInfo,
 				W minVariance = 0,
 				size_t maxIteration = 100) override;
 
-		private:
+		protected:
+
+			/**
+			 *	@brief Select initial centroids with the configured strategy
+			 */
+			std::vector<V> _init(
+				int k,
+				const std::vector<V>& vertices,
+				const brandes::VertexInfoMatrix<V, W>& vertexInfo);
 
 			std::vector<V> _initPlusPlus(
 				int k,
 				const std::vector<V>& vertices,
-				const std::vector<std::shared_ptr<brandes::VertexInfo<V, W>>>& vertexInfo);
+				const brandes::VertexInfoMatrix<V, W>& vertexInfo);
+
+			std::vector<V> _initParallel(
+				int k,
+				const std::vector<V>& vertices,
+				const brandes::VertexInfoMatrix<V, W>& vertexInfo);
 
 			W _centroidVariance(
 				const std::vector<V>& oldCentroid,
 				const std::vector<V>& newCentroid,
-				const std::vector<std::shared_ptr<brandes::VertexInfo<V, W>>>& vertexInfo);
+				const brandes::VertexInfoMatrix<V, W>& vertexInfo);
+
+		private:
+
+			/**
+			 *	@brief Candidates expected from each PARALLEL sampling round, as a fraction of k
+			 */
+			static constexpr double PARALLEL_OVERSAMPLING = 1.0;
+
+			/**
+			 *	@brief PARALLEL sampling stops when candidates are this fraction of k
+			 */
+			static constexpr double PARALLEL_CANDIDATES = 2.0;
+
+			/**
+			 *	@brief Vertices updated by each PARALLEL initialization task
+			 */
+			static constexpr size_t PARALLEL_GRAIN = 256;
+
+			/**
+			 *	@brief Candidates compared with a block of vertices at a time
+			 */
+			static constexpr size_t PARALLEL_TILE = 64;
+
+			// Bits mixing function, random choices depend on keys and not on threads scheduling
+			static std::uint64_t _mix(std::uint64_t key);
+
+			const Initialization _initialization;
+			const unsigned int _seed;
 
 			struct InfoCluster { 
 				brandes::VertexInfo<W, W> centroidInfo;
@@ -67,21 +138,27 @@ namespace fastbc {
 	}
 }
 
+template<typename V, typename W>
+fastbc::kmeans::PlusPlusKMeans<V, W>::PlusPlusKMeans(Initialization initialization, unsigned int seed)
+	: _initialization(initialization), _seed(seed)
+{
+}
+
 template<typename V, typename W>
 std::pair<std::vector<V>, std::vector<V>>
 fastbc::kmeans::PlusPlusKMeans<V, W>::computeCentroids(
 	int k,
 	const std::vector<V>& vertices,
 	const std::vector<V>& weights,
-	const std::vector<std::shared_ptr<brandes::VertexInfo<V, W>>>& vertexInfo,
+	const brandes::VertexInfoMatrix<V, W>& vertexInfo,
 	W minVariance,
 	size_t maxIteration)
 {
 	// Current centroids vector
-	std::vector<V> newCentroid = _initPlusPlus(k, vertices, vertexInfo);
+	std::vector<V> newCentroid = _init(k, vertices, vertexInfo);
 	std::vector<V> centroid(newCentroid.size());
 
-	std::vector<struct InfoCluster> infoCluster(centroid.size(), InfoCluster(vertexInfo[vertices[0]]->borders()));
+	std::vector<struct InfoCluster> infoCluster(centroid.size(), InfoCluster(vertexInfo.borders()));
 	struct InfoCluster* _infoCluster = infoCluster.data();
 	size_t _infoClusterSize = infoCluster.size();
 
@@ -95,14 +172,14 @@ fastbc::kmeans::PlusPlusKMeans<V, W>::computeCentroids(
 		#pragma omp parallel for reduction(+:_infoCluster[:_infoClusterSize])
 		for (size_t v = 0; v < vertices.size(); ++v)
 		{
-			struct VertexDistance minC(0, 
-				vertexInfo[centroid[0]]->squaredDistance(*vertexInfo[vertices[v]]));
+			const auto vVI = vertexInfo.row(vertices[v]);
+			struct VertexDistance minC(0, vertexInfo.row(centroid[0]).squaredDistance(vVI));
 
 			// Select nearest cluster to current vertex
 			#pragma omp simd reduction(min:minC)
 			for (int c = 1; c < centroid.size(); ++c)
 			{
-				W dist = vertexInfo[centroid[c]]->squaredDistance(*vertexInfo[vertices[v]]);
+				W dist = vertexInfo.row(centroid[c]).squaredDistance(vVI);
 
 				if (dist < minC.distance)
 				{
@@ -112,7 +189,7 @@ fastbc::kmeans::PlusPlusKMeans<V, W>::computeCentroids(
 			}
 
 			// Store vertex association to selected cluster
-			_infoCluster[minC.vertex].centroidInfo += *vertexInfo[vertices[v]];
+			_infoCluster[minC.vertex].centroidInfo += vVI;
 			_infoCluster[minC.vertex].vIndices.push_back(v);
 		}
 
@@ -128,13 +205,13 @@ fastbc::kmeans::PlusPlusKMeans<V, W>::computeCentroids(
 			ic.centroidInfo /= ic.vIndices.size();
 
 			struct VertexDistance minV(ic.vIndices[0],
-				ic.centroidInfo.squaredDistance(*vertexInfo[vertices[ic.vIndices[0]]]));
+				ic.centroidInfo.squaredDistance(vertexInfo.row(vertices[ic.vIndices[0]])));
 
 			// New centroid will be the nearest existing vertex to computed centroid
 			#pragma omp simd reduction(min:minV)
 			for (size_t v = 1; v < ic.vIndices.size(); ++v)
 			{
-				W dist = ic.centroidInfo.squaredDistance(*vertexInfo[vertices[ic.vIndices[v]]]);
+				W dist = ic.centroidInfo.squaredDistance(vertexInfo.row(vertices[ic.vIndices[v]]));
 
 				if (dist < minV.distance)
 				{
@@ -169,12 +246,27 @@ fastbc::kmeans::PlusPlusKMeans<V, W>::computeCentroids(
 	return centroidWeights;
 }
 
+template<typename V, typename W>
+std::vector<V>
+fastbc::kmeans::PlusPlusKMeans<V, W>::_init(
+	int k,
+	const std::vector<V>& vertices,
+	const brandes::VertexInfoMatrix<V, W>& vertexInfo)
+{
+	if (_initialization == Initialization::PARALLEL)
+	{
+		return _initParallel(k, vertices, vertexInfo);
+	}
+
+	return _initPlusPlus(k, vertices, vertexInfo);
+}
+
 template<typename V, typename W>
 std::vector<V>
 fastbc::kmeans::PlusPlusKMeans<V, W>::_initPlusPlus(
 	int k,
 	const std::vector<V>& vertices,
-	const std::vector<std::shared_ptr<brandes::VertexInfo<V, W>>>& vertexInfo)
+	const brandes::VertexInfoMatrix<V, W>& vertexInfo)
 {
 	std::vector<V> centroid(k);
 	centroid[0] = vertices[0];
@@ -182,7 +274,7 @@ fastbc::kmeans::PlusPlusKMeans<V, W>::_initPlusPlus(
 	std::vector<W> cDist(vertices.size(), 0);
 	for (int i = 1; i < k; ++i)
 	{
-		std::shared_ptr<brandes::VertexInfo<V, W>> lastCentroid = vertexInfo[centroid[i - 1]];
+		const auto lastCentroid = vertexInfo.row(centroid[i - 1]);
 		double p = 1.0 / i;
 		double _p = 1.0 - p;
 
@@ -191,7 +283,7 @@ fastbc::kmeans::PlusPlusKMeans<V, W>::_initPlusPlus(
 		for (int v = 0; v < vertices.size(); ++v)
 		{
 			// Update distance from prevoiusly selected centroids
-			cDist[v] = cDist[v] * _p + lastCentroid->squaredDistance(*vertexInfo[vertices[v]]) * p;
+			cDist[v] = cDist[v] * _p + lastCentroid.squaredDistance(vertexInfo.row(vertices[v])) * p;
 
 			// Update farthest from existing centroids
 			if (cDist[v] > cDist[farthestV])
@@ -206,18 +298,197 @@ fastbc::kmeans::PlusPlusKMeans<V, W>::_initPlusPlus(
 	return centroid;
 }
 
+template<typename V, typename W>
+std::vector<V>
+fastbc::kmeans::PlusPlusKMeans<V, W>::_initParallel(
+	int k,
+	const std::vector<V>& vertices,
+	const brandes::VertexInfoMatrix<V, W>& vertexInfo)
+{
+	size_t vertexCount = vertices.size();
+
+	// Candidate centroids, first one is the first vertex as for PLUSPLUS initialization
+	std::vector<V> candidate(1, vertices[0]);
+
+	// Squared distance of each vertex from the nearest candidate and candidate index
+	std::vector<W> minDist(vertexCount, std::numeric_limits<W>::max());
+	std::vector<size_t> nearest(vertexCount, 0);
+	std::vector<char> sampled(vertexCount, 0);
+
+	const double oversampling = std::max(PARALLEL_OVERSAMPLING * k, 1.0);
+	size_t compared = 0;
+	for (std::uint64_t round = 0; ; ++round)
+	{
+		// Only candidates added by last round must be compared
+		size_t candidateCount = candidate.size();
+
+		// Summed as double, a sum of integral distances could overflow the weight type
+		double cost = 0;
+
+		// Each task compares a block of vertices with a cache sized tile of candidates at a time
+		size_t blockCount = (vertexCount + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+
+		#pragma omp taskloop grainsize(1) reduction(+:cost) shared(vertices, vertexInfo, candidate, minDist, nearest, compared, candidateCount)
+		for (size_t block = 0; block < blockCount; ++block)
+		{
+			size_t vBegin = block * PARALLEL_GRAIN;
+			size_t vEnd = std::min(vBegin + PARALLEL_GRAIN, vertexCount);
+
+			for (size_t cBegin = compared; cBegin < candidateCount; cBegin += PARALLEL_TILE)
+			{
+				size_t cEnd = std::min(cBegin + PARALLEL_TILE, candidateCount);
+
+				for (size_t v = vBegin; v < vEnd; ++v)
+				{
+					const auto vVI = vertexInfo.row(vertices[v]);
+					W vDist = minDist[v];
+					size_t vNearest = nearest[v];
+					for (size_t c = cBegin; c < cEnd; ++c)
+					{
+						W dist = vertexInfo.row(candidate[c]).squaredDistance(vVI);
+						if (dist < vDist)
+						{
+							vDist = dist;
+							vNearest = c;
+						}
+					}
+
+					minDist[v] = vDist;
+					nearest[v] = vNearest;
+				}
+			}
+
+			for (size_t v = vBegin; v < vEnd; ++v)
+			{
+				cost += (double)minDist[v];
+			}
+		}
+
+		compared = candidateCount;
+
+		// Every vertex is as near as possible or enough candidates
+		if (cost == 0 || candidateCount >= vertexCount ||
+			candidateCount >= PARALLEL_CANDIDATES * k)
+		{
+			break;
+		}
+
+		// Sample each vertex independently, proportionally to its distance
+		std::uint64_t roundKey = _mix(((std::uint64_t)_seed << 32) | round);
+
+		#pragma omp taskloop grainsize(PARALLEL_GRAIN) shared(minDist, sampled, cost, oversampling, roundKey)
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			double uniform = (_mix(roundKey ^ v) >> 11) * 0x1.0p-53;
+			sampled[v] = uniform * cost < oversampling * (double)minDist[v];
+		}
+
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			if (sampled[v])
+			{
+				candidate.push_back(vertices[v]);
+			}
+		}
+	}
+
+	size_t candidateCount = candidate.size();
+	if (candidateCount <= (size_t)k)
+	{
+		// Too few distinct vertices, every candidate is a centroid and no cluster is left empty
+		return candidate;
+	}
+
+	// Each candidate is weighted by the number of vertices it is the nearest to
+	std::vector<double> candidateWeight(candidateCount, 0.0);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		candidateWeight[nearest[v]] += 1;
+	}
+
+	// Weighted k-means++ on candidates
+	std::mt19937 generator(_seed);
+	std::vector<V> centroid(k);
+	std::vector<double> cDist(candidateCount, std::numeric_limits<double>::max());
+	std::vector<char> chosen(candidateCount, 0);
+
+	size_t last = std::discrete_distribution<size_t>(
+		candidateWeight.begin(), candidateWeight.end())(generator);
+	for (int i = 0; i < k; ++i)
+	{
+		centroid[i] = candidate[last];
+		chosen[last] = 1;
+
+		if (i + 1 == k)
+		{
+			break;
+		}
+
+		// Update weighted distance from the nearest centroid
+		const auto lastCentroid = vertexInfo.row(centroid[i]);
+		double total = 0;
+
+		#pragma omp taskloop grainsize(PARALLEL_GRAIN) reduction(+:total) shared(vertexInfo, candidate, candidateWeight, cDist, lastCentroid)
+		for (size_t c = 0; c < candidateCount; ++c)
+		{
+			cDist[c] = std::min(cDist[c],
+				candidateWeight[c] * (double)lastCentroid.squaredDistance(vertexInfo.row(candidate[c])));
+			total += cDist[c];
+		}
+
+		// Next centroid proportionally to weighted distance, first not chosen one if all are covered;
+		// rounding may leave part of the threshold, then the last not chosen candidate is taken
+		last = 0;
+		if (total > 0)
+		{
+			double threshold = std::uniform_real_distribution<double>(0, total)(generator);
+			for (size_t c = 0; c < candidateCount; ++c)
+			{
+				if (chosen[c])
+				{
+					continue;
+				}
+
+				last = c;
+				if (threshold < cDist[c])
+				{
+					break;
+				}
+
+				threshold -= cDist[c];
+			}
+		}
+		else
+		{
+			while (chosen[last]) { ++last; }
+		}
+	}
+
+	return centroid;
+}
+
+template<typename V, typename W>
+std::uint64_t fastbc::kmeans::PlusPlusKMeans<V, W>::_mix(std::uint64_t key)
+{
+	key += 0x9e3779b97f4a7c15ull;
+	key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+	key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+
+	return key ^ (key >> 31);
+}
+
 template<typename V, typename W>
 W fastbc::kmeans::PlusPlusKMeans<V, W>::_centroidVariance(
 	const std::vector<V>& oldCentroid,
 	const std::vector<V>& newCentroid,
-	const std::vector<std::shared_ptr<brandes::VertexInfo<V, W>>>& vertexInfo)
+	const brandes::VertexInfoMatrix<V, W>& vertexInfo)
 {
 	W maxVariance = 0;
 
 	#pragma omp simd reduction(max:maxVariance)
 	for (int c = 0; c < oldCentroid.size(); ++c)
 	{
-		W variance = vertexInfo[oldCentroid[c]]->squaredDistance(*vertexInfo[newCentroid[c]]);
+		W variance = vertexInfo.row(oldCentroid[c]).squaredDistance(vertexInfo.row(newCentroid[c]));
 
 		if (variance > maxVariance)
 		{
@@ -1,43 +1,56 @@
 #ifndef FASTBC_LOUVAIN_LOUVAINGRAPH_H
 #define FASTBC_LOUVAIN_LOUVAINGRAPH_H
 
+#include <CSRGraph.h>
+
+#include <memory>
+#include <utility>
+
 namespace fastbc {
 	namespace louvain {
 
+		// Read-only view of in/out links of a graph, stored in CSR format.
+		// A CSRGraph is referenced without copying its arrays, other graphs
+		// are first copied into a CSRGraph.
 		template<typename V, typename W>
 		class LouvainGraph {
 		 public:
 			typedef std::shared_ptr<const IDegreeGraph<V,W>> Graph;
-			
+			typedef typename CSRGraph<V, W>::offset_t offset_t;
+
 			unsigned int nb_nodes;
 			unsigned long nb_links;
-			W total_weight;    
+			W total_weight;
 
-			std::vector<unsigned long> indegrees;
-			std::vector<V> inlinks;
-			std::vector<W> inweights;
+			// cumulative degree of each node (i.e. end of its links)
+			const offset_t* indegrees;
+			const V* inlinks;
+			const W* inweights;
 
-            std::vector<unsigned long> outdegrees;
-            std::vector<V> outlinks;
-            std::vector<W> outweights;
+            const offset_t* outdegrees;
+            const V* outlinks;
+            const W* outweights;
 
-			LouvainGraph() {}
 			LouvainGraph(Graph graph);
 
 			// return the number of neighbors (degree) of the node
-			inline unsigned int nb_in_neighbors(V node);
-            inline unsigned int nb_out_neighbors(V node);
+			inline unsigned int nb_in_neighbors(V node) const;
+            inline unsigned int nb_out_neighbors(V node) const;
 
 			// return the number of self loops of the node
-			inline W weighted_selfloops(V node);
+			inline W weighted_selfloops(V node) const;
 
 			// return the weighted degree of the node
-			inline W weighted_in_degree(V node);
-            inline W weighted_out_degree(V node);
+			inline W weighted_in_degree(V node) const;
+            inline W weighted_out_degree(V node) const;
 
 			// return pointers to the first neighbor and first weight of the node
-			inline std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator > in_neighbors(V node);
-            inline std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator > out_neighbors(V node);
+			inline std::pair<const V*, const W*> in_neighbors(V node) const;
+            inline std::pair<const V*, const W*> out_neighbors(V node) const;
+
+		 private:
+			// graph owning the referenced CSR arrays
+			std::shared_ptr<const CSRGraph<V, W> > csr;
 		};
 
 	}
@@ -45,40 +58,29 @@ namespace fastbc {
 
 template<typename V, typename W>
 fastbc::louvain::LouvainGraph<V, W>::LouvainGraph(Graph graph) {
-    nb_nodes = graph->vertices().size();
-    nb_links = graph->edges();
-
-    indegrees.resize(nb_nodes);
-    inlinks.resize(nb_links);
-    inweights.resize(nb_links);
-
-    outdegrees.resize(nb_nodes);
-    outlinks.resize(nb_links);
-    outweights.resize(nb_links);
-
-    unsigned long intot = 0, outtot = 0;
-    total_weight = 0;
-    for(int i=0; i<nb_nodes; i++) {
-        for(auto &[v, w]: graph->backwardStar(i)) {
-            inlinks[intot] = v;
-            inweights[intot] = w;
-            intot += 1;
-            total_weight += w;
-        }
-        indegrees[i] = intot;
-
-        for(auto &[v, w]: graph->forwardStar(i)) {
-            outlinks[outtot] = v;
-            outweights[outtot] = w;
-            outtot += 1;
-        }
-        outdegrees[i] = outtot;
-    }
+    csr = std::dynamic_pointer_cast<const CSRGraph<V, W> >(graph);
+    if (!csr)
+        csr = std::make_shared<const CSRGraph<V, W> >(*graph);
+
+    nb_nodes = csr->vertices().size();
+    nb_links = csr->edges();
+
+    // offsets start with a leading zero, degrees[node-1] is the begin of node links
+    indegrees = csr->inOffsets() + 1;
+    inlinks = csr->inSources();
+    inweights = csr->inWeights();
+
+    outdegrees = csr->outOffsets() + 1;
+    outlinks = csr->outTargets();
+    outweights = csr->outWeights();
+
+    // summed in parallel when the CSR graph is built
+    total_weight = csr->totalWeight();
 }
 
 template<typename V, typename W>
 inline unsigned int
-fastbc::louvain::LouvainGraph<V, W>::nb_in_neighbors(V node) {
+fastbc::louvain::LouvainGraph<V, W>::nb_in_neighbors(V node) const {
     if (node==0)
         return indegrees[0];
     else
@@ -87,7 +89,7 @@ fastbc::louvain::LouvainGraph<V, W>::nb_in_neighbors(V node) {
 
 template<typename V, typename W>
 inline unsigned int
-fastbc::louvain::LouvainGraph<V, W>::nb_out_neighbors(V node) {
+fastbc::louvain::LouvainGraph<V, W>::nb_out_neighbors(V node) const {
     if (node==0)
         return outdegrees[0];
     else
@@ -96,70 +98,54 @@ fastbc::louvain::LouvainGraph<V, W>::nb_out_neighbors(V node) {
 
 template<typename V, typename W>
 inline W
-fastbc::louvain::LouvainGraph<V, W>::weighted_selfloops(V node) {
-    std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator > p = out_neighbors(node);
+fastbc::louvain::LouvainGraph<V, W>::weighted_selfloops(V node) const {
+    std::pair<const V*, const W*> p = out_neighbors(node);
     for (unsigned int i=0 ; i<nb_out_neighbors(node) ; i++) {
-        if (*(p.first+i)==node) {
-            if (outweights.size()!=0)
-				return (W)*(p.second+i);
-            else 
-				return 1.;
-        }
+        if (*(p.first+i)==node)
+			return (W)*(p.second+i);
     }
     return 0.;
 }
 
 template<typename V, typename W>
 inline W
-fastbc::louvain::LouvainGraph<V, W>::weighted_in_degree(V node) {
-    if (inweights.size()==0)
-        return (W)nb_in_neighbors(node);
-    else {
-        std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator > p = in_neighbors(node);
-        W res = 0;
-        for (unsigned int i=0 ; i<nb_in_neighbors(node) ; i++) {
-            res += (W)*(p.second+i);
-        }
-        return res;
+fastbc::louvain::LouvainGraph<V, W>::weighted_in_degree(V node) const {
+    std::pair<const V*, const W*> p = in_neighbors(node);
+    W res = 0;
+    for (unsigned int i=0 ; i<nb_in_neighbors(node) ; i++) {
+        res += (W)*(p.second+i);
     }
+    return res;
 }
 
 template<typename V, typename W>
 inline W
-fastbc::louvain::LouvainGraph<V, W>::weighted_out_degree(V node) {
-    if (outweights.size()==0)
-        return (W)nb_out_neighbors(node);
-    else {
-        std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator > p = out_neighbors(node);
-        W res = 0;
-        for (unsigned int i=0 ; i<nb_out_neighbors(node) ; i++) {
-            res += (W)*(p.second+i);
-        }
-        return res;
+fastbc::louvain::LouvainGraph<V, W>::weighted_out_degree(V node) const {
+    std::pair<const V*, const W*> p = out_neighbors(node);
+    W res = 0;
+    for (unsigned int i=0 ; i<nb_out_neighbors(node) ; i++) {
+        res += (W)*(p.second+i);
     }
+    return res;
 }
 
 template<typename V, typename W>
-inline std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator >
-fastbc::louvain::LouvainGraph<V, W>::in_neighbors(V node) {
+inline std::pair<const V*, const W*>
+fastbc::louvain::LouvainGraph<V, W>::in_neighbors(V node) const {
     if (node==0)
-        return std::make_pair(inlinks.begin(), inweights.begin());
-    else if (inweights.size()!=0)
-        return std::make_pair(inlinks.begin()+indegrees[node-1], inweights.begin()+indegrees[node-1]);
+        return std::make_pair(inlinks, inweights);
     else
-        return std::make_pair(inlinks.begin()+indegrees[node-1], inweights.begin());
+        return std::make_pair(inlinks+indegrees[node-1], inweights+indegrees[node-1]);
 }
 
 template<typename V, typename W>
-inline std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator >
-fastbc::louvain::LouvainGraph<V, W>::out_neighbors(V node) {
+inline std::pair<const V*, const W*>
+fastbc::louvain::LouvainGraph<V, W>::out_neighbors(V node) const {
     if (node==0)
-        return std::make_pair(outlinks.begin(), outweights.begin());
-    else if (outweights.size()!=0)
-        return std::make_pair(outlinks.begin()+outdegrees[node-1], outweights.begin()+outdegrees[node-1]);
+        return std::make_pair(outlinks, outweights);
     else
-        return std::make_pair(outlinks.begin()+outdegrees[node-1], outweights.begin());
+        return std::make_pair(outlinks+outdegrees[node-1], outweights+outdegrees[node-1]);
 }
 
 
-#endif
\ No newline at end of file
+#endif
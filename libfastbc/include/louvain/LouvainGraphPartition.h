@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <random>
+#include <set>
 #include <spdlog/spdlog.h>
 
 namespace fastbc {
@@ -22,6 +23,8 @@ namespace fastbc {
 
 			double _precision;	
 			int _parallelism;
+			bool _parallelMoves;
+			bool _activePruning;
 			std::vector<std::mt19937> _seed;
 
 			void
@@ -70,10 +73,31 @@ namespace fastbc {
 
 
 		public:
+
+			/**
+			 *	@brief Initialize a Louvain graph partitioner
+			 *
+			 *	@details Each level runs an instance for each seed, keeping the partition
+			 *			 with best modularity. With parallel moves, the local moving phase
+			 *			 of each instance moves vertices concurrently too, so threads beyond
+			 *			 the number of instances are used as well. With active pruning,
+			 *			 local moving passes after the first one only visit vertices
+			 *			 with a neighbor moved in the previous pass: passes are much
+			 *			 cheaper on large sparse graphs, but may end in a partition
+			 *			 with lower modularity.
+			 *
+			 *	@param seeds Seed of each parallel instance
+			 *	@param precision Minimum modularity increase for a new local moving pass
+			 *	@param parallelMoves Move vertices concurrently in each instance
+			 *	@param activePruning Only visit vertices with moved neighbors in later passes
+			 */
 			LouvainGraphPartition(
 				const std::set<std::mt19937::result_type>& seeds, 
-				double precision = 0.01)
-				: _parallelism(seeds.size()), _precision(precision)
+				double precision = 0.01,
+				bool parallelMoves = false,
+				bool activePruning = false)
+				: _parallelism(seeds.size()), _precision(precision), _parallelMoves(parallelMoves),
+				_activePruning(activePruning)
 			{
 				for (auto& seed : seeds)
 				{
@@ -83,10 +107,11 @@ namespace fastbc {
 				
 			Result partitionGraph(Graph graph) override
 			{
-			    LouvainGraph<V, W> g(graph);
-			    std::vector<Partition<V, W> > p(_parallelism, Partition<V, W>(g, _precision));
-			    std::vector<V> n2c(g.nb_nodes);
-			    for(int i=0; i<g.nb_nodes; i++) n2c[i] = i;
+			    // Instances only own their community state, the graph of each level is shared
+			    std::shared_ptr<const LouvainGraph<V, W> > g = std::make_shared<const LouvainGraph<V, W> >(graph);
+			    std::vector<Partition<V, W> > p(_parallelism, Partition<V, W>(g, _precision, _activePruning));
+			    std::vector<V> n2c(g->nb_nodes);
+			    for(int i=0; i<g->nb_nodes; i++) n2c[i] = i;
 			    std::vector<bool> improvements(_parallelism, true);
 			    std::vector<double> modularities(_parallelism);
 			    int best_i = 0;
@@ -97,11 +122,13 @@ namespace fastbc {
 
 			    do {
 					SPDLOG_DEBUG("Level: {}\n\tNetwork size: {} vertices, {} edges, {} weight",
-						level, g.nb_nodes, g.nb_links, g.total_weight);
+						level, g->nb_nodes, g->nb_links, g->total_weight);
 
+			        // Threads not running an instance execute parallel moves tasks while waiting
 			        #pragma omp parallel for
 			        for(int i=0; i<_parallelism; i++) {
-			        	improvements[i] = p[i].one_level(_seed[i]);
+			        	improvements[i] = _parallelMoves ?
+			        		p[i].one_level_parallel(_seed[i]) : p[i].one_level(_seed[i]);
 			        	modularities[i] = p[i].modularity();
 			        }
 
@@ -112,10 +139,10 @@ namespace fastbc {
 
 			        improvement = improvements[best_i];
 			        new_mod = p[best_i].modularity();
-			        g = p[best_i].partition2graph();
+			        g = std::make_shared<const LouvainGraph<V, W> >(p[best_i].partition2graph());
 			        renumber_communities(n2c, p[best_i].n2c);
-			        for(int i=0; i<_parallelism; i++)
-			        	p[i] = Partition<V, W> (g, _precision);
+			        // Previous level graph is released once no instance references it
+			        p.assign(_parallelism, Partition<V, W> (g, _precision, _activePruning));
 
 					SPDLOG_DEBUG("Modularity increased from {} to {}", mod, new_mod);
 
@@ -3,6 +3,9 @@
 
 #include <louvain/LouvainGraph.h>
 #include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
 #include <random>
 
 namespace fastbc {
@@ -10,7 +13,7 @@ namespace fastbc {
 		template <typename V, typename W>
 		class Partition {
 		public:
-			LouvainGraph<V,W> g; // network to compute communities for
+			std::shared_ptr<const LouvainGraph<V,W> > g; // network to compute communities for, shared by all instances
 			int size; // nummber of nodes in the network and size of all std::vectors
 
 			std::vector<double> neigh_weight;
@@ -35,9 +38,18 @@ namespace fastbc {
 			// if 0. even a minor increase is enough to go for one more pass
 			double min_modularity;
 
-			Partition(LouvainGraph<V, W>& gc, double minm)  {
+			// if true, passes after the first one only visit nodes with a neighbor
+			// moved in the previous pass
+			bool active_pruning;
+
+			// modularity terms maintained by remove and insert, so that modularity
+			// needs no sweep over all nodes after each pass
+			double sum_woutc,   // weight of links inside communities
+                   sum_wctot;   // sum of woutctot*winctot over all communities
+
+			Partition(std::shared_ptr<const LouvainGraph<V, W> > gc, double minm, bool pruning = false)  {
 			    g = gc;
-			    size = g.nb_nodes;
+			    size = g->nb_nodes;
 
 			    neigh_weight.resize(size,-1);
 			    neigh_pos.resize(size);
@@ -53,13 +65,15 @@ namespace fastbc {
 
 			    for (int i=0 ; i<size ; i++) {
 			        n2c[i] = i;
-			        woutc[i] = winc[i] = g.weighted_selfloops(i);
-                    wout[i] = woutctot[i] = g.weighted_out_degree(i);
-                    win[i] = winctot[i] = g.weighted_in_degree(i);
+			        woutc[i] = winc[i] = g->weighted_selfloops(i);
+                    wout[i] = woutctot[i] = g->weighted_out_degree(i);
+                    win[i] = winctot[i] = g->weighted_in_degree(i);
 			    }
 
 			    nb_pass = -1;
 			    min_modularity = minm;
+			    active_pruning = pruning;
+			    reset_modularity();
 			}
 
 			// remove the node from its current community with which it has dnodecomm links
@@ -75,7 +89,7 @@ namespace fastbc {
 			// for each community, gives the number of links from node to comm
 			void neigh_comm(unsigned int node);
 
-			// compute the modularity of the current partition
+			// modularity of the current partition, as tracked by remove and insert
 			double modularity();
 
 			// generates the binary graph of communities as computed by one_level
@@ -86,7 +100,53 @@ namespace fastbc {
 			bool one_level(std::mt19937& seed);
 			bool one_level(std::vector<int> evaluation_order);
 
+			// compute communities of the graph for one level, moving nodes concurrently
+			// nodes are visited in random order, results depend on threads scheduling
+			// return true if some nodes have been moved
+			bool one_level_parallel(std::mt19937& seed);
+
             void write_communities();
+
+        private:
+			// nodes moved by each task of the parallel local moving phase
+			static constexpr int PARALLEL_MOVE_GRAIN = 512;
+
+			// move node to the neighboring community with the best modularity gain,
+			// neighbors holds (community, weight) pairs of node links
+			// return the former community of node if it has been moved, -1 else
+			int parallel_move(int node, std::vector<std::pair<int, double> >& neighbors,
+				std::vector<int>& comm_size);
+
+			// sum of weights of node links towards its own community
+			void update_community_weights(int node);
+
+			// recompute sum_woutc and sum_wctot from node and community weights
+			void reset_modularity();
+
+			// append node to nodes unless already flagged, flags are set concurrently
+			// by parallel local moving
+			static void activate(int node, std::vector<char>& flag, std::vector<int>& nodes);
+
+			// activate in and out neighbors of node, whose best community may have changed
+			void activate_neighbors(int node, std::vector<char>& flag, std::vector<int>& nodes);
+
+			// prepare nodes visited by the next pass from the ones activated in this pass
+			// and clear their flags; every node is visited again after a pruned pass
+			// without moves or when pruning is disabled
+			// return true if next pass visits every node
+			bool next_pass_nodes(int nb_moves, bool full_pass, std::vector<int>& active,
+				std::vector<int>& next_active, std::vector<char>& flag);
+
+			// communities coarsened by each task of partition2graph
+			static constexpr int COARSENING_GRAIN = 64;
+
+			// aggregate links of the nodes of each community (CSR given by degrees,
+			// links and weights) into links between communities, sorted by community;
+			// comm_offsets has a leading zero, as CSRGraph offsets
+			static void coarsen_links(
+				const typename LouvainGraph<V, W>::offset_t* degrees, const V* links, const W* weights,
+				const std::vector<int>& node_comm, const std::vector<int>& comm_offset, const std::vector<int>& comm_nodes,
+				std::vector<typename LouvainGraph<V, W>::offset_t>& comm_offsets, std::vector<V>& comm_links, std::vector<W>& comm_weights);
         };
     }
 }
@@ -94,29 +154,39 @@ namespace fastbc {
 template<typename V, typename W>
 inline void
 fastbc::louvain::Partition<V, W>::remove(int node) {
+  int comm = n2c[node];
+  // woutc and winc of node are outdated once a neighbor moved in or out of comm,
+  // links of node inside comm are counted once in sum_woutc
+  update_community_weights(node);
+  sum_woutc -= woutc[node] + winc[node] - g->weighted_selfloops(node);
+  sum_wctot -= woutctot[comm]*winctot[comm];
   woutc[node] = 0;
   winc[node] = 0;
-  woutctot[n2c[node]] -= g.weighted_out_degree(node);
-  winctot[n2c[node]] -= g.weighted_in_degree(node);
+  woutctot[comm] -= g->weighted_out_degree(node);
+  winctot[comm] -= g->weighted_in_degree(node);
+  sum_wctot += woutctot[comm]*winctot[comm];
   n2c[node]  = -1;
 }
 
 template <typename V, typename W>
 inline void
 fastbc::louvain::Partition<V, W>::insert(int node, int comm) {
+  sum_wctot -= woutctot[comm]*winctot[comm];
   n2c[node]=comm;
-  std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator > pin = g.out_neighbors(node);
-  for (unsigned int i=0 ; i<g.nb_out_neighbors(node) ; i++) {
+  std::pair<const V*, const W*> pin = g->out_neighbors(node);
+  for (unsigned int i=0 ; i<g->nb_out_neighbors(node) ; i++) {
       if(n2c[(V)*(pin.first+i)] == comm)
         woutc[node] += (W)*(pin.second+i);
   }
-  std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator > pout = g.in_neighbors(node);
-  for (unsigned int i=0 ; i<g.nb_in_neighbors(node) ; i++) {
+  std::pair<const V*, const W*> pout = g->in_neighbors(node);
+  for (unsigned int i=0 ; i<g->nb_in_neighbors(node) ; i++) {
       if(n2c[(V)*(pout.first+i)] == comm)
         winc[node] += (W)*(pout.second+i);
   }
-  woutctot[comm] += g.weighted_out_degree(node);
-  winctot[comm] += g.weighted_out_degree(node);
+  woutctot[comm] += g->weighted_out_degree(node);
+  winctot[comm] += g->weighted_in_degree(node);
+  sum_wctot += woutctot[comm]*winctot[comm];
+  sum_woutc += woutc[node] + winc[node] - g->weighted_selfloops(node);
 }
 
 template <typename V, typename W>
@@ -126,7 +196,7 @@ fastbc::louvain::Partition<V, W>::modularity_gain(int node, int comm, double wic
   double winn   = win[node];
   double winc   = winctot[comm];
   double woutc  = woutctot[comm];
-  double m      = (double) g.total_weight;
+  double m      = (double) g->total_weight;
 
   /*std::cout << "wic   : " << wic << std::endl;
   std::cout << "woutn : " << woutn << std::endl;
@@ -141,14 +211,57 @@ fastbc::louvain::Partition<V, W>::modularity_gain(int node, int comm, double wic
 
 template<typename V, typename W>
 double fastbc::louvain::Partition<V, W>::modularity() {
-    double q    = 0.;
-    double m = (double)g.total_weight;
+    // weight inside communities over m, minus the product of out and in weights
+    // of each community over m*m
+    double m = (double)g->total_weight;
+    return sum_woutc/m - sum_wctot/(m*m);
+}
+
+template<typename V, typename W>
+void fastbc::louvain::Partition<V, W>::reset_modularity() {
+    sum_woutc = 0.;
+    sum_wctot = 0.;
     for (int i=0 ; i<size ; i++) {
-        if (wout[i]>0){
-            q += (double)woutc[i]/m - ((double)wout[i]/m)*((double)winctot[n2c[i]]/m);
-        }
+        sum_woutc += woutc[i];
+        sum_wctot += woutctot[i]*winctot[i];
     }
-    return q;
+}
+
+template<typename V, typename W>
+void fastbc::louvain::Partition<V, W>::activate(int node, std::vector<char>& flag, std::vector<int>& nodes) {
+    char flagged;
+    #pragma omp atomic capture
+    { flagged = flag[node]; flag[node] = 1; }
+
+    if (!flagged)
+        nodes.push_back(node);
+}
+
+template<typename V, typename W>
+void fastbc::louvain::Partition<V, W>::activate_neighbors(int node, std::vector<char>& flag, std::vector<int>& nodes) {
+    std::pair<const V*, const W*> pin  = g->in_neighbors(node);
+    std::pair<const V*, const W*> pout = g->out_neighbors(node);
+
+    for (unsigned int i=0 ; i<g->nb_in_neighbors(node) ; i++)
+        activate(*(pin.first+i), flag, nodes);
+    for (unsigned int i=0 ; i<g->nb_out_neighbors(node) ; i++)
+        activate(*(pout.first+i), flag, nodes);
+}
+
+template<typename V, typename W>
+bool fastbc::louvain::Partition<V, W>::next_pass_nodes(int nb_moves, bool full_pass,
+    std::vector<int>& active, std::vector<int>& next_active, std::vector<char>& flag) {
+    for (const auto& node : next_active)
+        flag[node] = 0;
+
+    bool next_full_pass = !active_pruning || (nb_moves==0 && !full_pass);
+    if (next_full_pass)
+        next_active.clear();
+
+    active.swap(next_active);
+    next_active.clear();
+
+    return next_full_pass;
 }
 
 template<typename V, typename W>
@@ -157,11 +270,11 @@ void fastbc::louvain::Partition<V, W>::neigh_comm(unsigned int node) {
         neigh_weight[neigh_pos[i]]=-1;
     neigh_last=0;
 
-    std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator> pin     = g.in_neighbors(node);
-    std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator> pout    = g.out_neighbors(node);
+    std::pair<const V*, const W*> pin     = g->in_neighbors(node);
+    std::pair<const V*, const W*> pout    = g->out_neighbors(node);
 
-    unsigned int indeg  = g.nb_in_neighbors(node);
-    unsigned int outdeg = g.nb_out_neighbors(node);
+    unsigned int indeg  = g->nb_in_neighbors(node);
+    unsigned int outdeg = g->nb_out_neighbors(node);
 
     neigh_pos[0]=n2c[node];
     neigh_weight[neigh_pos[0]]=0;
@@ -170,7 +283,7 @@ void fastbc::louvain::Partition<V, W>::neigh_comm(unsigned int node) {
     for (unsigned int i=0 ; i<indeg ; i++) {
         unsigned int neigh          = *(pin.first+i);
         unsigned int neigh_comm     = n2c[neigh];
-        double neigh_w = (g.inweights.size()==0)?1.:*(pin.second+i);
+        double neigh_w = *(pin.second+i);
         
         if (neigh!=node) {
             if (neigh_weight[neigh_comm]==-1) {
@@ -185,7 +298,7 @@ void fastbc::louvain::Partition<V, W>::neigh_comm(unsigned int node) {
         unsigned int neigh          = *(pout.first+i);
         if(neigh != node) {
             unsigned int neigh_comm     = n2c[neigh];
-            double neigh_w = (g.outweights.size()==0)?1.:*(pout.second+i);
+            double neigh_w = *(pout.second+i);
             
             if (neigh_weight[neigh_comm]==-1) {
                     neigh_weight[neigh_comm]=0.;
@@ -210,76 +323,104 @@ fastbc::louvain::LouvainGraph<V, W> fastbc::louvain::Partition<V, W>::partition2
         if (renumber[i]!=-1)
             renumber[i]=final++;
 
-    // Compute communities
-    std::vector<std::vector<int> > comm_nodes(final);
+    // Compute communities, nodes of each community are sorted by index
+    std::vector<int> node_comm(size);
+    std::vector<int> comm_offset(final + 1, 0);
     for (int node=0 ; node<size ; node++) {
-        comm_nodes[renumber[n2c[node]]].push_back(node);
+        node_comm[node] = renumber[n2c[node]];
+        comm_offset[node_comm[node] + 1]++;
+    }
+    for (int comm=0 ; comm<final ; comm++)
+        comm_offset[comm + 1] += comm_offset[comm];
+
+    std::vector<int> comm_nodes(size);
+    {
+        std::vector<int> cursor(comm_offset.begin(), comm_offset.end() - 1);
+        for (int node=0 ; node<size ; node++)
+            comm_nodes[cursor[node_comm[node]]++] = node;
     }
 
-    // Compute weighted graph
-    LouvainGraph<V, W> g2;
-    g2.nb_nodes = comm_nodes.size();
-    g2.total_weight = 0;
-    g2.nb_links = 0;
-    g2.indegrees.resize(comm_nodes.size());
-    g2.outdegrees.resize(comm_nodes.size());
-
-    int comm_deg = comm_nodes.size();
-    for (int comm=0 ; comm<comm_deg ; comm++) {
-        std::map<int,double> inm;
-        std::map<int, double> outm;
-        std::map<int,double>::iterator it;
-
-        int comm_size = comm_nodes[comm].size();
-        for (int node=0 ; node<comm_size ; node++) {
-            std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator> pin;
-            pin = g.in_neighbors(comm_nodes[comm][node]);
-            int indeg = g.nb_in_neighbors(comm_nodes[comm][node]);
-            for (int i=0 ; i<indeg ; i++) {
-            	int neigh           = *(pin.first+i);
-            	int neigh_comm      = renumber[n2c[neigh]];
-            	double neigh_weight = (g.inweights.size()==0)?1.:*(pin.second+i);
-
-            	it = inm.find(neigh_comm);
-            	if (it==inm.end())
-            	    inm.insert(std::make_pair(neigh_comm, neigh_weight));
-            	else
-            	    it->second+=neigh_weight;
-            }
+    // Compute weighted graph, stored by a CSRGraph the new level references
+    std::vector<typename LouvainGraph<V, W>::offset_t> in_offsets, out_offsets;
+    std::vector<V> in_links, out_links;
+    std::vector<W> in_weights, out_weights;
 
-            std::pair<typename std::vector<V>::iterator, typename std::vector<W>::iterator> pout;
-            pout = g.out_neighbors(comm_nodes[comm][node]);
-            int outdeg = g.nb_out_neighbors(comm_nodes[comm][node]);
-            for (int i=0 ; i<outdeg ; i++) {
-                int neigh           = *(pout.first+i);
-                int neigh_comm      = renumber[n2c[neigh]];
-                double neigh_weight = (g.outweights.size()==0)?1.:*(pout.second+i);
-
-                it = outm.find(neigh_comm);
-                if (it==outm.end())
-                    outm.insert(std::make_pair(neigh_comm, neigh_weight));
-                else
-                    it->second+=neigh_weight;
-            }
+    coarsen_links(g->indegrees, g->inlinks, g->inweights, node_comm, comm_offset, comm_nodes,
+        in_offsets, in_links, in_weights);
+    coarsen_links(g->outdegrees, g->outlinks, g->outweights, node_comm, comm_offset, comm_nodes,
+        out_offsets, out_links, out_weights);
+
+    return LouvainGraph<V, W>(std::make_shared<const CSRGraph<V, W> >(
+        std::move(out_offsets), std::move(out_links), std::move(out_weights),
+        std::move(in_offsets), std::move(in_links), std::move(in_weights)));
+}
+
+template<typename V, typename W>
+void fastbc::louvain::Partition<V, W>::coarsen_links(
+    const typename LouvainGraph<V, W>::offset_t* degrees, const V* links, const W* weights,
+    const std::vector<int>& node_comm, const std::vector<int>& comm_offset, const std::vector<int>& comm_nodes,
+    std::vector<typename LouvainGraph<V, W>::offset_t>& comm_offsets, std::vector<V>& comm_links, std::vector<W>& comm_weights) {
+    int nb_comms = comm_offset.size() - 1;
+
+    // Each community owns a segment of (neighbor community, weight) pairs, as long as
+    // the sum of its nodes degrees
+    std::vector<unsigned long> segment(nb_comms + 1, 0);
+    for (int comm=0 ; comm<nb_comms ; comm++) {
+        unsigned long deg = 0;
+        for (int i=comm_offset[comm] ; i<comm_offset[comm + 1] ; i++) {
+            int node = comm_nodes[i];
+            deg += degrees[node] - (node==0 ? 0 : degrees[node-1]);
         }
-        g2.indegrees[comm]=(comm==0)? inm.size() : g2.indegrees[comm-1]+inm.size();
-        g2.outdegrees[comm]=(comm==0)? outm.size() : g2.outdegrees[comm-1]+outm.size();
-        g2.nb_links+=inm.size();
+        segment[comm + 1] = segment[comm] + deg;
+    }
 
-        
-        for (it = inm.begin() ; it!=inm.end() ; it++) {
-            g2.total_weight    += it->second;
-            g2.inlinks.push_back(it->first);
-            g2.inweights.push_back(it->second);
+    std::vector<std::pair<int, double> > pairs(segment[nb_comms]);
+    std::vector<unsigned long> unique(nb_comms);
+
+    // Fill, sort and aggregate the segment of each community
+    // stable sort keeps nodes and links order, so weights are summed in the same order
+    #pragma omp parallel for schedule(dynamic, COARSENING_GRAIN)
+    for (int comm=0 ; comm<nb_comms ; comm++) {
+        unsigned long pos = segment[comm];
+        for (int i=comm_offset[comm] ; i<comm_offset[comm + 1] ; i++) {
+            int node = comm_nodes[i];
+            for (unsigned long e=(node==0 ? 0 : degrees[node-1]) ; e<degrees[node] ; e++)
+                pairs[pos++] = std::make_pair(node_comm[links[e]], (double)weights[e]);
         }
 
-        for (it = outm.begin() ; it!=outm.end() ; it++) {
-            g2.outlinks.push_back(it->first);
-            g2.outweights.push_back(it->second);
+        auto begin = pairs.begin() + segment[comm];
+        auto end = pairs.begin() + segment[comm + 1];
+        std::stable_sort(begin, end,
+            [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+
+        auto last = begin;
+        for (auto it=begin ; it!=end ; it++) {
+            if (it==begin)
+                continue;
+            if (it->first==last->first)
+                last->second += it->second;
+            else
+                *(++last) = *it;
         }
+        unique[comm] = (begin==end) ? 0 : (last - begin + 1);
     }
 
-    return g2;
+    // Compact aggregated segments into the coarse graph CSR
+    comm_offsets.assign(nb_comms + 1, 0);
+    for (int comm=0 ; comm<nb_comms ; comm++)
+        comm_offsets[comm + 1] = comm_offsets[comm] + unique[comm];
+
+    comm_links.resize(comm_offsets[nb_comms]);
+    comm_weights.resize(comm_links.size());
+
+    #pragma omp parallel for schedule(dynamic, COARSENING_GRAIN)
+    for (int comm=0 ; comm<nb_comms ; comm++) {
+        unsigned long out = comm_offsets[comm];
+        for (unsigned long i=0 ; i<unique[comm] ; i++) {
+            comm_links[out + i] = pairs[segment[comm] + i].first;
+            comm_weights[out + i] = pairs[segment[comm] + i].second;
+        }
+    }
 }
 
 /*
@@ -302,6 +443,14 @@ bool fastbc::louvain::Partition<V, W>::one_level(std::vector<int> random_order)
     double new_mod     = modularity();
     double cur_mod     = new_mod;
 
+    // with active pruning, first pass visits every node and later ones only nodes
+    // with a neighbor moved in the previous pass, as most nodes settle in their
+    // community early; a pruned pass without moves is followed by a full one,
+    // so that the level ends only when no node at all can be moved
+    std::vector<int> active, next_active;
+    std::vector<char> flag(active_pruning ? size : 0, 0);
+    bool full_pass, next_full_pass = true;
+
     // repeat while 
     //     there is an improvement of modularity
     //     or there is an improvement of modularity greater than a given epsilon 
@@ -314,11 +463,13 @@ bool fastbc::louvain::Partition<V, W>::one_level(std::vector<int> random_order)
 
         nb_moves = 0;
         nb_pass_done++;
+        full_pass = next_full_pass;
+        int nb_visits = full_pass ? size : (int)active.size();
 
         // for each node: remove the node from its community and insert it in the best community
-        for (int node_tmp=0 ; node_tmp<size ; node_tmp++) {
+        for (int node_tmp=0 ; node_tmp<nb_visits ; node_tmp++) {
 //            int node = node_tmp;
-            int node = random_order[node_tmp];
+            int node = full_pass ? random_order[node_tmp] : active[node_tmp];
 
             //cerr << "Node " << node << ": " << endl << endl;
             int node_comm         = n2c[node];
@@ -351,17 +502,22 @@ bool fastbc::louvain::Partition<V, W>::one_level(std::vector<int> random_order)
          
             //cerr << "New modularity: " << modularity() << endl << endl;
 
-            if (best_comm!=node_comm)
+            if (best_comm!=node_comm) {
                 nb_moves++;
+                if (active_pruning)
+                    activate_neighbors(node, flag, next_active);
+            }
         }
 
+        next_full_pass = next_pass_nodes(nb_moves, full_pass, active, next_active, flag);
+
         new_mod = modularity();
         //cerr << "Final iteration modularity: " << new_mod << endl;
         //cerr << "======== End Iteration ========    " << endl;
         if (nb_moves>0)
             improvement=true;
         
-    } while (nb_moves>0 && new_mod-cur_mod>min_modularity);
+    } while ((nb_moves>0 && new_mod-cur_mod>min_modularity) || (nb_moves==0 && !full_pass));
 
     /*std::cout << "Communities: " << std::endl;
     write_communities();*/
@@ -369,6 +525,227 @@ bool fastbc::louvain::Partition<V, W>::one_level(std::vector<int> random_order)
     return improvement;
 }
 
+template<typename V, typename W>
+bool fastbc::louvain::Partition<V, W>::one_level_parallel(std::mt19937& seed) {
+    std::vector<int> random_order(size);
+    for (int i=0 ; i<size ; i++)
+        random_order[i]=i;
+    std::shuffle(random_order.begin(), random_order.end(), seed);
+
+    // number of nodes of each community, singleton communities need special care
+    std::vector<int> comm_size(size, 0);
+    for (int node=0 ; node<size ; node++)
+        comm_size[n2c[node]]++;
+
+    // product of in and out weights of each community, as summed in sum_wctot
+    std::vector<double> comm_term(size);
+    sum_wctot = 0.;
+    for (int comm=0 ; comm<size ; comm++) {
+        comm_term[comm] = woutctot[comm]*winctot[comm];
+        sum_wctot += comm_term[comm];
+    }
+
+    bool improvement=false;
+    int nb_moves;
+    double new_mod = modularity();
+    double cur_mod = new_mod;
+
+    // nodes visited by each pass, as in sequential one_level; moved nodes and
+    // their neighbors are activated anyway, as their links towards their own
+    // community must be computed again, and so are communities whose weights changed
+    std::vector<int> active, next_active, changed_comms;
+    std::vector<char> flag(size, 0), comm_flag(size, 0);
+    bool full_pass, next_full_pass = true;
+
+    do {
+        cur_mod = new_mod;
+        nb_moves = 0;
+        full_pass = next_full_pass;
+        int nb_visits = full_pass ? size : (int)active.size();
+        int nb_blocks = (nb_visits + PARALLEL_MOVE_GRAIN - 1) / PARALLEL_MOVE_GRAIN;
+
+        // each task moves a block of nodes, reading communities and their weights
+        // while other tasks update them (optimistic local moving)
+        #pragma omp taskloop grainsize(1) reduction(+:nb_moves) shared(random_order, comm_size, active, next_active, changed_comms, flag, comm_flag)
+        for (int block=0 ; block<nb_blocks ; block++) {
+            std::vector<std::pair<int, double> > neighbors;
+            std::vector<int> activated, changed;
+            int end = std::min(nb_visits, (block + 1) * PARALLEL_MOVE_GRAIN);
+
+            for (int node_tmp=block * PARALLEL_MOVE_GRAIN ; node_tmp<end ; node_tmp++) {
+                int node = full_pass ? random_order[node_tmp] : active[node_tmp];
+
+                int former_comm = parallel_move(node, neighbors, comm_size);
+                if (former_comm!=-1) {
+                    nb_moves++;
+                    activate(node, flag, activated);
+                    activate_neighbors(node, flag, activated);
+                    activate(former_comm, comm_flag, changed);
+                    activate(n2c[node], comm_flag, changed);
+                }
+            }
+
+            #pragma omp critical(louvain_activate)
+            {
+                next_active.insert(next_active.end(), activated.begin(), activated.end());
+                changed_comms.insert(changed_comms.end(), changed.begin(), changed.end());
+            }
+        }
+
+        // links towards own community, as computed by insert in sequential one_level
+        double woutc_delta = 0.;
+        #pragma omp taskloop grainsize(PARALLEL_MOVE_GRAIN) reduction(+:woutc_delta) shared(next_active)
+        for (size_t i=0 ; i<next_active.size() ; i++) {
+            int node = next_active[i];
+            woutc_delta -= woutc[node];
+            update_community_weights(node);
+            woutc_delta += woutc[node];
+        }
+        sum_woutc += woutc_delta;
+
+        for (const auto& comm : changed_comms) {
+            sum_wctot -= comm_term[comm];
+            comm_term[comm] = woutctot[comm]*winctot[comm];
+            sum_wctot += comm_term[comm];
+            comm_flag[comm] = 0;
+        }
+        changed_comms.clear();
+
+        next_full_pass = next_pass_nodes(nb_moves, full_pass, active, next_active, flag);
+
+        new_mod = modularity();
+        if (nb_moves>0)
+            improvement=true;
+
+    } while ((nb_moves>0 && new_mod-cur_mod>min_modularity) || (nb_moves==0 && !full_pass));
+
+    return improvement;
+}
+
+template<typename V, typename W>
+int fastbc::louvain::Partition<V, W>::parallel_move(int node,
+    std::vector<std::pair<int, double> >& neighbors, std::vector<int>& comm_size) {
+    int node_comm;
+    #pragma omp atomic read
+    node_comm = n2c[node];
+
+    // links weight towards each neighboring community, own community first
+    neighbors.clear();
+    neighbors.emplace_back(node_comm, 0.);
+
+    std::pair<const V*, const W*> pin  = g->in_neighbors(node);
+    std::pair<const V*, const W*> pout = g->out_neighbors(node);
+    unsigned int indeg  = g->nb_in_neighbors(node);
+    unsigned int outdeg = g->nb_out_neighbors(node);
+
+    for (unsigned int i=0 ; i<indeg ; i++) {
+        int neigh = *(pin.first+i);
+        if (neigh!=node) {
+            int neigh_comm;
+            #pragma omp atomic read
+            neigh_comm = n2c[neigh];
+            neighbors.emplace_back(neigh_comm, *(pin.second+i));
+        }
+    }
+
+    for (unsigned int i=0 ; i<outdeg ; i++) {
+        int neigh = *(pout.first+i);
+        if (neigh!=node) {
+            int neigh_comm;
+            #pragma omp atomic read
+            neigh_comm = n2c[neigh];
+            neighbors.emplace_back(neigh_comm, *(pout.second+i));
+        }
+    }
+
+    // merge weights of the same community, own community stays first
+    std::sort(neighbors.begin() + 1, neighbors.end());
+    size_t last = 0;
+    for (size_t i=1 ; i<neighbors.size() ; i++) {
+        if (neighbors[i].first==node_comm)
+            neighbors[0].second += neighbors[i].second;
+        else if (last>0 && neighbors[i].first==neighbors[last].first)
+            neighbors[last].second += neighbors[i].second;
+        else
+            neighbors[++last] = neighbors[i];
+    }
+    neighbors.resize(last + 1);
+
+    // gain of inserting node in comm, as if node had been removed from its community
+    double m = (double) g->total_weight;
+    auto gain = [&](int comm, double wic) {
+        double winc, woutc;
+        #pragma omp atomic read
+        winc = winctot[comm];
+        #pragma omp atomic read
+        woutc = woutctot[comm];
+        if (comm==node_comm) {
+            winc -= win[node];
+            woutc -= wout[node];
+        }
+        return wic/m - (wout[node]/m)*(winc/m) - (win[node]/m)*(woutc/m);
+    };
+
+    // default choice is the former community
+    int best_comm        = node_comm;
+    double best_increase = 0.;
+    for (const auto& [comm, wic] : neighbors) {
+        double increase = gain(comm, wic);
+        if (increase>best_increase) {
+            best_comm     = comm;
+            best_increase = increase;
+        }
+    }
+
+    if (best_comm==node_comm)
+        return -1;
+
+    // two singleton nodes could keep swapping their communities,
+    // a singleton node only joins another singleton with a lower label
+    int node_comm_size, best_comm_size;
+    #pragma omp atomic read
+    node_comm_size = comm_size[node_comm];
+    #pragma omp atomic read
+    best_comm_size = comm_size[best_comm];
+    if (node_comm_size==1 && best_comm_size==1 && best_comm>node_comm)
+        return -1;
+
+    #pragma omp atomic
+    woutctot[node_comm] -= wout[node];
+    #pragma omp atomic
+    winctot[node_comm] -= win[node];
+    #pragma omp atomic
+    woutctot[best_comm] += wout[node];
+    #pragma omp atomic
+    winctot[best_comm] += win[node];
+    #pragma omp atomic
+    comm_size[node_comm]--;
+    #pragma omp atomic
+    comm_size[best_comm]++;
+    #pragma omp atomic write
+    n2c[node] = best_comm;
+
+    return node_comm;
+}
+
+template<typename V, typename W>
+void fastbc::louvain::Partition<V, W>::update_community_weights(int node) {
+    int comm = n2c[node];
+    woutc[node] = 0;
+    winc[node] = 0;
+
+    std::pair<const V*, const W*> pin = g->out_neighbors(node);
+    for (unsigned int i=0 ; i<g->nb_out_neighbors(node) ; i++) {
+        if(n2c[(V)*(pin.first+i)] == comm)
+            woutc[node] += (W)*(pin.second+i);
+    }
+    std::pair<const V*, const W*> pout = g->in_neighbors(node);
+    for (unsigned int i=0 ; i<g->nb_in_neighbors(node) ; i++) {
+        if(n2c[(V)*(pout.first+i)] == comm)
+            winc[node] += (W)*(pout.second+i);
+    }
+}
+
 template<typename V, typename W>
 void fastbc::louvain::Partition<V, W>::write_communities() {
   std::map<int, std::vector<int> > comms;
@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+
+#include <CSRGraph.h>
+
+#include <DirectedWeightedGraph.h>
+#include <exception>
+#include <fstream>
+#include <memory>
+
+using namespace fastbc;
+
+TEST_CASE("CSR graph constructor/getters", "[fastbc]")
+{
+	std::ifstream dwgText("DWGtext.txt");
+	if (!dwgText.is_open())
+	{
+		throw std::runtime_error("Unable to read test graph file.");
+	}
+
+	DirectedWeightedGraph<int, double> textGraph(dwgText);
+
+	std::shared_ptr<IDegreeGraph<int, double>> graph;
+
+	REQUIRE_NOTHROW(graph = std::make_shared<CSRGraph<int, double>>(textGraph));
+
+	REQUIRE(graph->vertices().size() == 9);
+	REQUIRE(graph->edges() == 16);
+	REQUIRE(graph->totalWeight() == textGraph.totalWeight());
+
+	const auto& fs = graph->forwardStar(4);
+	REQUIRE(fs.size() == 3);
+	REQUIRE(fs.find(5)->second == 1);
+	REQUIRE(fs.find(6)->second == 5);
+	REQUIRE(fs.find(8)->second == 3);
+	REQUIRE(fs.find(7) == fs.end());
+
+	// Neighbors are contiguous and sorted
+	REQUIRE(fs.vertices()[0] == 5);
+	REQUIRE(fs.vertices()[1] == 6);
+	REQUIRE(fs.vertices()[2] == 8);
+	REQUIRE(fs.weights()[1] == 5);
+
+	const auto& bs = graph->backwardStar(4);
+	REQUIRE(bs.size() == 3);
+	REQUIRE(bs.find(0)->second == 7);
+	REQUIRE(bs.find(2)->second == 4);
+	REQUIRE(bs.find(3)->second == 3);
+
+	REQUIRE(graph->edge(7, 5) == 2);
+	REQUIRE(graph->edge(0, 1) == 4);
+	REQUIRE(graph->edge(1, 0) == 0);
+
+	for (int v = 0; v < 9; ++v)
+	{
+		REQUIRE(graph->inWeightedDegree(v) == textGraph.inWeightedDegree(v));
+		REQUIRE(graph->outWeightedDegree(v) == textGraph.outWeightedDegree(v));
+	}
+}
+
+TEST_CASE("CSR graph from arrays", "[fastbc]")
+{
+	// 0 -> 1 (2), 0 -> 2 (1), 2 -> 1 (3)
+	CSRGraph<int, double> graph(
+		{ 0, 2, 2, 3 }, { 1, 2, 1 }, { 2, 1, 3 },
+		{ 0, 0, 2, 3 }, { 0, 2, 0 }, { 2, 3, 1 });
+
+	REQUIRE(graph.vertices().size() == 3);
+	REQUIRE(graph.edges() == 3);
+	REQUIRE(graph.totalWeight() == 6);
+	REQUIRE(graph.forwardStar(1).empty());
+	REQUIRE(graph.edge(2, 1) == 3);
+	REQUIRE(graph.backwardStar(1).size() == 2);
+	REQUIRE_FALSE(graph.uniformWeights());
+
+	CSRGraph<int, double> uniformGraph(
+		{ 0, 2, 2, 3 }, { 1, 2, 1 }, { 2, 2, 2 },
+		{ 0, 0, 2, 3 }, { 0, 2, 0 }, { 2, 2, 2 });
+	REQUIRE(uniformGraph.uniformWeights());
+
+	REQUIRE_THROWS(CSRGraph<int, double>({ 0, 1 }, {}, {}, { 0, 0 }, {}, {}));
+}
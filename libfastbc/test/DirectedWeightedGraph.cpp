@@ -2,6 +2,7 @@
 
 #include <DirectedWeightedGraph.h>
 
+#include <algorithm>
 #include <exception>
 #include <fstream>
 #include <memory>
@@ -29,7 +30,7 @@ TEST_CASE("Directed weighted graph constructor/getters", "[fastbc]")
 	REQUIRE(fs.find(6)->second == 5);
 	REQUIRE(fs.find(8)->second == 3);
 
-	auto& bs = graph->backwardStar(4);
+	const auto& bs = graph->backwardStar(4);
 	REQUIRE(bs.size() == 3);
 	REQUIRE(bs.find(0)->second == 7);
 	REQUIRE(bs.find(2)->second == 4);
@@ -38,4 +39,35 @@ TEST_CASE("Directed weighted graph constructor/getters", "[fastbc]")
 	REQUIRE(graph->edge(7, 5) == 2);
 	REQUIRE(graph->edge(0, 1) == 4);
 	REQUIRE(graph->edge(1, 0) == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Directed weighted graph stars are sorted and merged by initVertices", "[fastbc]")
+{
+	DirectedWeightedGraph<int, double> graph;
+
+	// Hub edges inserted in decreasing order, with duplicates
+	const int leaves = 1000;
+	for (int v = leaves; v > 0; --v)
+	{
+		graph.addEdge(0, v, 1.0);
+		graph.addEdge(v, 0, 2.0);
+	}
+	graph.addEdge(0, 7, 3.0);
+	graph.addEdge(7, 0, 1.0);
+	graph.initVertices();
+
+	REQUIRE(graph.vertices().size() == leaves + 1);
+	REQUIRE(graph.edges() == 2 * leaves);
+
+	const auto fs = graph.forwardStar(0);
+	REQUIRE(fs.size() == leaves);
+	REQUIRE(std::is_sorted(fs.vertices(), fs.vertices() + fs.size()));
+	REQUIRE(std::adjacent_find(fs.vertices(), fs.vertices() + fs.size()) == fs.vertices() + fs.size());
+	REQUIRE(graph.edge(0, 7) == 4.0);
+	REQUIRE(graph.edge(7, 0) == 3.0);
+	REQUIRE(graph.backwardStar(0).find(7)->second == 3.0);
+	REQUIRE(graph.backwardStar(7).find(0)->second == 4.0);
+
+	REQUIRE(graph.totalWeight() == 3.0 * leaves + 4.0);
+	REQUIRE(graph.outWeightedDegree(0) == leaves + 3.0);
+}
@@ -6,6 +6,8 @@
 #include <exception>
 #include <fstream>
 #include <memory>
+#include <set>
+#include <vector>
 
 using namespace fastbc;
 
@@ -44,4 +46,63 @@ TEST_CASE("SubGraph contructor and getters", "[fastbc]")
 	REQUIRE(subGraph->isBorder(4));
 
 	REQUIRE(subGraph->referenceGraph() == graph);
-}
\ No newline at end of file
+}
+
+TEST_CASE("SubGraph partition shares labels and filters border stars", "[fastbc]")
+{
+	std::ifstream dwgText("DWGtext.txt");
+	if (!dwgText.is_open())
+	{
+		throw std::runtime_error("Unable to read test graph file.");
+	}
+
+	std::shared_ptr<IGraph<int, double>> graph = std::make_shared<DirectedWeightedGraph<int, double>>(dwgText);
+
+	auto subGraphs = SubGraph<int, double>::fromPartition(
+		std::vector<std::vector<int>>({ { 0, 1, 2, 3, 4 }, { 5, 6, 7, 8 } }), graph);
+
+	REQUIRE(subGraphs.size() == 2);
+
+	// Same sub-graph as the one built from its own vertices
+	SubGraph<int, double> single(std::vector<int>({ 0, 1, 2, 3, 4 }), graph);
+	REQUIRE(subGraphs[0]->edges() == single.edges());
+	REQUIRE(subGraphs[0]->borders() == single.borders());
+	for (int v = 0; v < 5; ++v)
+	{
+		REQUIRE(subGraphs[0]->forwardStar(v).size() == single.forwardStar(v).size());
+		REQUIRE(subGraphs[0]->backwardStar(v).size() == single.backwardStar(v).size());
+	}
+
+	REQUIRE(subGraphs[1]->edges() == 5);
+	REQUIRE(subGraphs[1]->borders() == std::set<int>({ 5, 6, 8 }));
+	REQUIRE_FALSE(subGraphs[1]->isBorder(7));
+	REQUIRE_FALSE(subGraphs[1]->isBorder(4));
+
+	// Border star is a view skipping edges leaving the sub-graph
+	const auto fs = subGraphs[0]->forwardStar(4);
+	REQUIRE(fs.filtered());
+	REQUIRE(fs.empty());
+	REQUIRE(fs.find(5) == fs.end());
+	REQUIRE(subGraphs[0]->edge(3, 5) == 0);
+	REQUIRE(subGraphs[0]->edge(3, 4) == 3);
+
+	const auto bs = subGraphs[1]->backwardStar(8);
+	std::vector<int> sources;
+	for (const auto& e : bs)
+	{
+		sources.push_back(e.first);
+	}
+	REQUIRE(sources == std::vector<int>({ 5, 7 }));
+	REQUIRE(bs.size() == 2);
+
+	// Iterator found in a filtered span keeps skipping filtered out edges
+	const int neighbors[] = { 0, 1, 2, 3, 4 };
+	const double weights[] = { 1, 2, 3, 4, 5 };
+	const int label[] = { 0, 1, 0, 1, 0 };
+	EdgeSpan<int, double> filtered(EdgeSpan<int, double>(neighbors, weights, 5), label, 0);
+	auto it = filtered.find(0);
+	REQUIRE((++it)->first == 2);
+	REQUIRE((++it)->second == 5);
+	REQUIRE(++it == filtered.end());
+	REQUIRE(filtered.find(1) == filtered.end());
+}
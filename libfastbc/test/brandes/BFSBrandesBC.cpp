@@ -0,0 +1,32 @@
+#include <catch2/catch.hpp>
+
+#include <brandes/BFSBrandesBC.h>
+
+#include <DirectedWeightedGraph.h>
+#include <memory>
+
+using namespace fastbc::brandes;
+
+TEST_CASE("Breadth first exact Brandes' BC computation test", "[brandes]")
+{
+	// 0 -> 1 -> 3, 0 -> 2 -> 3, 3 -> 4
+	auto graph = std::make_shared<fastbc::DirectedWeightedGraph<int, float>>();
+	graph->addEdge(0, 1, 2.0f);
+	graph->addEdge(0, 2, 2.0f);
+	graph->addEdge(1, 3, 2.0f);
+	graph->addEdge(2, 3, 2.0f);
+	graph->addEdge(3, 4, 2.0f);
+	graph->initVertices();
+
+	std::shared_ptr<IBrandesBC<int, float>> bfsBrandesBC =
+		std::make_shared<BFSBrandesBC<int, float>>();
+
+	std::vector<float> graphBC = bfsBrandesBC->computeBC(graph);
+
+	// Check betweenness centrality values
+	REQUIRE(graphBC[0] == 0.0f);
+	REQUIRE(graphBC[1] == 1.0f);
+	REQUIRE(graphBC[2] == 1.0f);
+	REQUIRE(graphBC[3] == 3.0f);
+	REQUIRE(graphBC[4] == 0.0f);
+}
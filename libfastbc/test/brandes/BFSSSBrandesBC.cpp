@@ -0,0 +1,76 @@
+#include <catch2/catch.hpp>
+
+#include <brandes/BFSSSBrandesBC.h>
+#include <brandes/DijkstraSSBrandesBC.h>
+
+#include <DirectedWeightedGraph.h>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+
+using namespace fastbc::brandes;
+
+TEST_CASE("Breadth first single source Brandes BC", "[brandes]")
+{
+	const int n = 100;
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> vertex(0, n - 1);
+
+	// Random graph with unit weights and many equal length shortest paths
+	std::set<std::pair<int, int>> edges;
+	for (int e = 0; e < 4 * n; ++e)
+	{
+		int from = vertex(rng), to = vertex(rng);
+		if (from != to)
+		{
+			edges.emplace(from, to);
+		}
+	}
+
+	auto graph = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	for (const auto& e : edges)
+	{
+		graph->addEdge(e.first, e.second, 1.0);
+	}
+	graph->initVertices();
+
+	BFSSSBrandesBC<int, double> bfsBC;
+	DijkstraSSBrandesBC<int, double> dijkstraBC;
+
+	for (const auto& src : graph->vertices())
+	{
+		std::vector<double> bfsDependency = bfsBC.singleSourceBrandes(src, graph);
+		std::vector<double> dijkstraDependency = dijkstraBC.singleSourceBrandes(src, graph);
+
+		REQUIRE(bfsDependency.size() == dijkstraDependency.size());
+		for (size_t v = 0; v < bfsDependency.size(); ++v)
+		{
+			REQUIRE(bfsDependency[v] == Approx(dijkstraDependency[v]));
+		}
+	}
+}
+
+TEST_CASE("Breadth first single source Brandes BC with tied integral paths", "[brandes]")
+{
+	// Diamond 0->{1,2}->3 followed by chain 3->4->5 with unit integral weights:
+	// vertices 1 and 2 get half of the paths to 3, 4 and 5 each
+	std::vector<std::pair<int, int>> edges = { {0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}, {4, 5} };
+
+	auto graph = std::make_shared<fastbc::DirectedWeightedGraph<int, long>>();
+	for (const auto& e : edges)
+	{
+		graph->addEdge(e.first, e.second, 1);
+	}
+	graph->initVertices();
+
+	BFSSSBrandesBC<int, long> bfsBC;
+	SSBrandesWorkspace<int, long> workspace;
+
+	bfsBC.singleSourceBrandes(0, graph, workspace);
+
+	REQUIRE(workspace.delta[1] == 1.5);
+	REQUIRE(workspace.delta[2] == 1.5);
+	REQUIRE(workspace.delta[3] == 2.0);
+	REQUIRE(workspace.delta[4] == 1.0);
+}
@@ -0,0 +1,73 @@
+#include <catch2/catch.hpp>
+
+#include <brandes/DependencyAccumulator.h>
+#include <brandes/DijkstraSSBrandesBC.h>
+
+#include <DirectedWeightedGraph.h>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+
+using namespace fastbc::brandes;
+
+static std::vector<double> accumulateAll(
+	std::shared_ptr<const fastbc::IGraph<int, double>> graph,
+	int threads,
+	size_t slotsPerThread)
+{
+	DijkstraSSBrandesBC<int, double> ssBC;
+	std::vector<double> bc(graph->vertices().size(), 0.0);
+	DependencyAccumulator<int, double> accumulator(bc, threads, slotsPerThread, 16);
+
+	accumulator.accumulate(graph->vertices().size(),
+		[&ssBC, &graph](size_t source, SSBrandesWorkspace<int, double>& workspace)
+		{
+			ssBC.singleSourceBrandes(source, graph, workspace);
+			return 0.5 + source % 3;
+		});
+
+	return bc;
+}
+
+TEST_CASE("Dependency accumulator", "[brandes]")
+{
+	const int n = 150;
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> vertex(0, n - 1);
+	std::uniform_real_distribution<double> weight(0.1, 10.0);
+
+	std::set<std::pair<int, int>> edges;
+	for (int e = 0; e < 3 * n; ++e)
+	{
+		int from = vertex(rng), to = vertex(rng);
+		if (from != to)
+		{
+			edges.emplace(from, to);
+		}
+	}
+
+	auto graph = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	for (const auto& e : edges)
+	{
+		graph->addEdge(e.first, e.second, weight(rng));
+	}
+	graph->initVertices();
+
+	// Sequential reference in source order
+	DijkstraSSBrandesBC<int, double> ssBC;
+	std::vector<double> expected(n, 0.0);
+	for (int src = 0; src < n; ++src)
+	{
+		std::vector<double> dependency = ssBC.singleSourceBrandes(src, graph);
+		for (int v = 0; v < n; ++v)
+		{
+			expected[v] += (0.5 + src % 3) * dependency[v];
+		}
+	}
+
+	// Sums are done in source order whatever the threads and slots count
+	REQUIRE(accumulateAll(graph, 1, 1) == expected);
+	REQUIRE(accumulateAll(graph, 3, 4) == expected);
+	REQUIRE(accumulateAll(graph, 4, 7) == expected);
+}
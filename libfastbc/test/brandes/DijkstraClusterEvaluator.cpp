@@ -2,11 +2,14 @@
 
 #include <brandes/DijkstraClusterEvaluator.h>
 
+#include <brandes/DijkstraSSBrandesBC.h>
 #include <DirectedWeightedGraph.h>
 #include <SubGraph.h>
 #include <exception>
 #include <fstream>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <valarray>
 #include <vector>
 
@@ -30,9 +33,9 @@ TEST_CASE("Dijkstra cluster evaluation test", "[brandes]")
 		std::make_shared<DijkstraClusterEvaluator<int, float>>();
 
 	std::vector<float> globalBC(fullGraph->vertices().size(), 0.0f);
-	std::vector<std::shared_ptr<VertexInfo<int, float>>> globalVertexInfo(fullGraph->vertices().size(), nullptr);
+	VertexInfoMatrix<int, float> clusterVertexInfo;
 
-	ce->evaluateCluster(globalBC, globalVertexInfo, subGraph);
+	ce->evaluateCluster(globalBC, clusterVertexInfo, subGraph);
 
 	// Check betweenness centrality values
 	REQUIRE(globalBC[0] == 2.0f);
@@ -46,30 +49,91 @@ TEST_CASE("Dijkstra cluster evaluation test", "[brandes]")
 		REQUIRE(globalBC[i] == 0.0f);
 	}
 
-	// Check vertices information
-
-	REQUIRE(globalVertexInfo[0]->getBorderSPCount(0) == 1);
-	REQUIRE(globalVertexInfo[0]->getBorderSPLength(0) == 5.0f);
-	REQUIRE(globalVertexInfo[0]->getBorderSPCount(1) == 2);
-	REQUIRE(globalVertexInfo[0]->getBorderSPLength(1) == 7.0f);
-
-	REQUIRE(globalVertexInfo[1]->getBorderSPCount(0) == 1);
-	REQUIRE(globalVertexInfo[1]->getBorderSPLength(0) == 1.0f);
-	REQUIRE(globalVertexInfo[1]->getBorderSPCount(1) == 1);
-	REQUIRE(globalVertexInfo[1]->getBorderSPLength(1) == 4.0f);
-
-	REQUIRE(globalVertexInfo[2]->getBorderSPCount(0) == 1);
-	REQUIRE(globalVertexInfo[2]->getBorderSPLength(0) == 8.0f);
-	REQUIRE(globalVertexInfo[2]->getBorderSPCount(1) == 1);
-	REQUIRE(globalVertexInfo[2]->getBorderSPLength(1) == 4.0f);
-
-	REQUIRE(globalVertexInfo[3]->getBorderSPCount(0) == 1);
-	REQUIRE(globalVertexInfo[3]->getBorderSPLength(0) == 0.0f);
-	REQUIRE(globalVertexInfo[3]->getBorderSPCount(1) == 1);
-	REQUIRE(globalVertexInfo[3]->getBorderSPLength(1) == 3.0f);
-
-	REQUIRE(globalVertexInfo[4]->getBorderSPCount(0) == 0);
-	REQUIRE(globalVertexInfo[4]->getBorderSPLength(0) == 0);
-	REQUIRE(globalVertexInfo[4]->getBorderSPCount(1) == 1);
-	REQUIRE(globalVertexInfo[4]->getBorderSPLength(1) == 0.0f);
-}
\ No newline at end of file
+	// Check vertices information, cluster vertices are stored in order
+	REQUIRE(clusterVertexInfo.rows() == 5);
+	REQUIRE(clusterVertexInfo.borders() == 2);
+
+	REQUIRE(clusterVertexInfo.row(0).getBorderSPCount(0) == 1);
+	REQUIRE(clusterVertexInfo.row(0).getBorderSPLength(0) == 5.0f);
+	REQUIRE(clusterVertexInfo.row(0).getBorderSPCount(1) == 2);
+	REQUIRE(clusterVertexInfo.row(0).getBorderSPLength(1) == 7.0f);
+
+	REQUIRE(clusterVertexInfo.row(1).getBorderSPCount(0) == 1);
+	REQUIRE(clusterVertexInfo.row(1).getBorderSPLength(0) == 1.0f);
+	REQUIRE(clusterVertexInfo.row(1).getBorderSPCount(1) == 1);
+	REQUIRE(clusterVertexInfo.row(1).getBorderSPLength(1) == 4.0f);
+
+	REQUIRE(clusterVertexInfo.row(2).getBorderSPCount(0) == 1);
+	REQUIRE(clusterVertexInfo.row(2).getBorderSPLength(0) == 8.0f);
+	REQUIRE(clusterVertexInfo.row(2).getBorderSPCount(1) == 1);
+	REQUIRE(clusterVertexInfo.row(2).getBorderSPLength(1) == 4.0f);
+
+	REQUIRE(clusterVertexInfo.row(3).getBorderSPCount(0) == 1);
+	REQUIRE(clusterVertexInfo.row(3).getBorderSPLength(0) == 0.0f);
+	REQUIRE(clusterVertexInfo.row(3).getBorderSPCount(1) == 1);
+	REQUIRE(clusterVertexInfo.row(3).getBorderSPLength(1) == 3.0f);
+
+	REQUIRE(clusterVertexInfo.row(4).getBorderSPCount(0) == 0);
+	REQUIRE(clusterVertexInfo.row(4).getBorderSPLength(0) == 0);
+	REQUIRE(clusterVertexInfo.row(4).getBorderSPCount(1) == 1);
+	REQUIRE(clusterVertexInfo.row(4).getBorderSPLength(1) == 0.0f);
+}
+TEST_CASE("Dijkstra cluster evaluation in chunk waves", "[brandes]")
+{
+	// Cluster large enough to be split in several chunks
+	const int n = 2000;
+	std::mt19937 rng(13);
+	std::uniform_int_distribution<int> vertex(0, n - 1);
+	std::uniform_real_distribution<double> weight(1.0, 4.0);
+
+	auto fullGraph = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	for (int e = 0; e < 4 * n; ++e)
+	{
+		int from = vertex(rng), to = vertex(rng);
+		if (from != to)
+		{
+			fullGraph->addEdge(from, to, weight(rng));
+		}
+	}
+	fullGraph->initVertices();
+
+	std::vector<int> vertices(n);
+	std::iota(vertices.begin(), vertices.end(), 0);
+	auto subGraph = std::make_shared<fastbc::SubGraph<int, double>>(vertices, fullGraph);
+
+	// Evaluate the cluster inside a parallel region with given number of threads
+	auto evaluate = [&subGraph](int threads)
+	{
+		DijkstraClusterEvaluator<int, double> ce;
+		std::vector<double> clusterBC(n, 0.0);
+		VertexInfoMatrix<int, double> clusterVertexInfo;
+
+		#pragma omp parallel num_threads(threads)
+		#pragma omp single
+		ce.evaluateCluster(clusterBC, clusterVertexInfo, subGraph);
+
+		return clusterBC;
+	};
+
+	std::vector<double> clusterBC = evaluate(1);
+
+	// Chunks are summed in the same order whatever the number of waves
+	REQUIRE(evaluate(3) == clusterBC);
+	REQUIRE(evaluate(8) == clusterBC);
+
+	DijkstraSSBrandesBC<int, double> ssBC;
+	std::vector<double> expected(n, 0.0);
+	for (int src = 0; src < n; ++src)
+	{
+		std::vector<double> dependency = ssBC.singleSourceBrandes(src, fullGraph);
+		for (int v = 0; v < n; ++v)
+		{
+			expected[v] += dependency[v];
+		}
+	}
+
+	for (int v = 0; v < n; ++v)
+	{
+		REQUIRE(clusterBC[v] == Approx(expected[v]).margin(1e-9));
+	}
+}
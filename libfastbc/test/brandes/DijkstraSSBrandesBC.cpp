@@ -6,6 +6,8 @@
 #include <SubGraph.h>
 #include <fstream>
 #include <memory>
+#include <random>
+#include <utility>
 
 using namespace fastbc::brandes;
 
@@ -26,4 +28,98 @@ TEST_CASE("Single source Brandes BC", "[brandes]")
 	std::vector<float> globalBC = ssBC->singleSourceBrandes(0, fullGraph);
 
 	REQUIRE(globalBC.size() == fullGraph->vertices().size());
-}
\ No newline at end of file
+}
+
+TEST_CASE("Single source Brandes BC with integral weights", "[brandes]")
+{
+	const int n = 200;
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> vertex(0, n - 1);
+	std::uniform_int_distribution<long> weight(1, 1000000);
+
+	// Wide weights range makes shortest paths unique, so dependencies are integral
+	auto intGraph = std::make_shared<fastbc::DirectedWeightedGraph<int, long>>();
+	auto realGraph = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	for (int e = 0; e < 5 * n; ++e)
+	{
+		int from = vertex(rng), to = vertex(rng);
+		long w = weight(rng);
+		if (from != to)
+		{
+			intGraph->addEdge(from, to, w);
+			realGraph->addEdge(from, to, (double)w);
+		}
+	}
+	intGraph->initVertices();
+	realGraph->initVertices();
+
+	DijkstraSSBrandesBC<int, long> intBC;
+	DijkstraSSBrandesBC<int, double> realBC;
+
+	// Radix heap kernel must match the comparison based one from every source
+	for (const auto& src : intGraph->vertices())
+	{
+		std::vector<long> intDependency = intBC.singleSourceBrandes(src, intGraph);
+		std::vector<double> realDependency = realBC.singleSourceBrandes(src, realGraph);
+
+		REQUIRE(intDependency.size() == realDependency.size());
+		for (size_t v = 0; v < intDependency.size(); ++v)
+		{
+			REQUIRE((double)intDependency[v] == realDependency[v]);
+		}
+	}
+}
+
+TEST_CASE("Single source Brandes BC with tied integral paths", "[brandes]")
+{
+	// Two equal length paths 0->1->3 and 0->2->3 followed by chain 3->4->5:
+	// vertices 1 and 2 get half of the paths to 3, 4 and 5 each
+	std::vector<std::pair<std::pair<int, int>, long>> edges = {
+		{{0, 1}, 2}, {{0, 2}, 1}, {{1, 3}, 1}, {{2, 3}, 2}, {{3, 4}, 3}, {{4, 5}, 3} };
+
+	auto intGraph = std::make_shared<fastbc::DirectedWeightedGraph<int, long>>();
+	auto realGraph = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	for (const auto& e : edges)
+	{
+		intGraph->addEdge(e.first.first, e.first.second, e.second);
+		realGraph->addEdge(e.first.first, e.first.second, (double)e.second);
+	}
+	intGraph->initVertices();
+	realGraph->initVertices();
+
+	DijkstraSSBrandesBC<int, long> intBC;
+	DijkstraSSBrandesBC<int, double> realBC;
+	SSBrandesWorkspace<int, long> workspace;
+
+	intBC.singleSourceBrandes(0, intGraph, workspace);
+	std::vector<double> realDependency = realBC.singleSourceBrandes(0, realGraph);
+
+	REQUIRE(workspace.delta[1] == 1.5);
+	REQUIRE(workspace.delta[2] == 1.5);
+	REQUIRE(workspace.delta == realDependency);
+}
+
+TEST_CASE("Single source Brandes BC workspace reuse", "[brandes]")
+{
+	std::ifstream dwgText("DWGtext.txt");
+	if (!dwgText.is_open())
+	{
+		throw std::runtime_error("Unable to read test graph file.");
+	}
+
+	std::shared_ptr<fastbc::IGraph<int, float>> fullGraph =
+		std::make_shared<fastbc::DirectedWeightedGraph<int, float>>(dwgText);
+
+	DijkstraSSBrandesBC<int, float> ssBC;
+	SSBrandesWorkspace<int, float> workspace;
+
+	// Reused workspace must give the same values as a fresh one for each source
+	for (const auto& src : fullGraph->vertices())
+	{
+		std::vector<float> expected = ssBC.singleSourceBrandes(src, fullGraph);
+		ssBC.singleSourceBrandes(src, fullGraph, workspace);
+
+		REQUIRE(workspace.visitOrder.front() == src);
+		REQUIRE(std::vector<float>(workspace.delta.begin(), workspace.delta.end()) == expected);
+	}
+}
@@ -0,0 +1,123 @@
+#include <catch2/catch.hpp>
+
+#include <brandes/VertexInfoMatrix.h>
+
+#include <brandes/VertexInfo.h>
+#include <cstdint>
+
+using namespace fastbc::brandes;
+
+TEST_CASE("Vertex info matrix storage", "[brandes]")
+{
+	VertexInfoMatrix<int, double> matrix(3, 5);
+
+	REQUIRE(matrix.rows() == 3);
+	REQUIRE(matrix.borders() == 5);
+
+	SECTION("Rows are zero initialized and aligned")
+	{
+		for (size_t r = 0; r < matrix.rows(); ++r)
+		{
+			auto row = matrix.row(r);
+
+			REQUIRE(row.borders() == 5);
+			REQUIRE((std::uintptr_t)row.lengths() % VertexInfoMatrix<int, double>::ROW_ALIGNMENT == 0);
+			REQUIRE((std::uintptr_t)row.counts() % VertexInfoMatrix<int, double>::ROW_ALIGNMENT == 0);
+
+			for (int b = 0; b < row.borders(); ++b)
+			{
+				REQUIRE(row.getBorderSPLength(b) == 0.0);
+				REQUIRE(row.getBorderSPCount(b) == 0);
+			}
+		}
+	}
+
+	SECTION("Rows do not overlap")
+	{
+		matrix.row(1).setBorderSPLength(4, 2.5);
+		matrix.row(1).setBorderSPCount(4, 3);
+
+		REQUIRE(matrix.row(0).getBorderSPLength(4) == 0.0);
+		REQUIRE(matrix.row(2).getBorderSPCount(0) == 0);
+		REQUIRE(matrix.row(1).getBorderSPLength(4) == 2.5);
+		REQUIRE(matrix.row(1).getBorderSPCount(4) == 3);
+
+		REQUIRE_THROWS(matrix.row(1).setBorderSPLength(5, 1.0));
+	}
+
+	SECTION("Resize clears values")
+	{
+		matrix.row(0).setBorderSPCount(0, 7);
+		matrix.resize(2, 2);
+
+		REQUIRE(matrix.rows() == 2);
+		REQUIRE(matrix.borders() == 2);
+		REQUIRE(matrix.row(0).getBorderSPCount(0) == 0);
+	}
+}
+
+TEST_CASE("Vertex info view operations", "[brandes]")
+{
+	VertexInfoMatrix<int, double> matrix(2, 4);
+	VertexInfo<int, double> vi(4);
+
+	const double lengths[] = { 2.3, 5.2, 1.1, 4.7 };
+	const int counts[] = { 2, 5, 1, 4 };
+	for (int b = 0; b < 4; ++b)
+	{
+		matrix.row(0).setBorderSPLength(b, lengths[b]);
+		matrix.row(0).setBorderSPCount(b, counts[b]);
+		matrix.row(1).setBorderSPLength(b, b);
+		matrix.row(1).setBorderSPCount(b, b);
+		vi.setBorderSPLength(b, lengths[b]);
+		vi.setBorderSPCount(b, counts[b]);
+	}
+
+	const auto& constMatrix = matrix;
+
+	SECTION("Same results as vertex info")
+	{
+		VertexInfo<int, double> other(4);
+		for (int b = 0; b < 4; ++b)
+		{
+			other.setBorderSPLength(b, b);
+			other.setBorderSPCount(b, b);
+		}
+
+		REQUIRE(constMatrix.row(0).squaredDistance(constMatrix.row(1)) == vi.squaredDistance(other));
+		REQUIRE(vi.squaredDistance(constMatrix.row(1)) == vi.squaredDistance(other));
+		REQUIRE(constMatrix.row(0).getMinBorderSPLength() == vi.getMinBorderSPLength());
+		REQUIRE(constMatrix.row(0).compare(constMatrix.row(1)) == vi.compare(other));
+	}
+
+	SECTION("Comparison")
+	{
+		REQUIRE(constMatrix.row(0) == vi.view());
+		REQUIRE(constMatrix.row(0) != constMatrix.row(1));
+		REQUIRE(constMatrix.row(1) < constMatrix.row(0));
+	}
+
+	SECTION("Normalization")
+	{
+		VertexInfo<int, double> normalized(4);
+		constMatrix.row(0).normalizeTo(normalized.view());
+		vi.normalize();
+
+		REQUIRE(normalized.view() == vi.view());
+		REQUIRE(normalized.getMinBorderSPLength() == 0.0);
+		REQUIRE(constMatrix.row(0).getMinBorderSPLength() == 1.1);
+	}
+
+	SECTION("Sum into vertex info")
+	{
+		VertexInfo<double, double> sum(4);
+		sum += constMatrix.row(0);
+		sum += constMatrix.row(1);
+
+		for (int b = 0; b < 4; ++b)
+		{
+			REQUIRE(sum.getBorderSPLength(b) == lengths[b] + b);
+			REQUIRE(sum.getBorderSPCount(b) == counts[b] + b);
+		}
+	}
+}
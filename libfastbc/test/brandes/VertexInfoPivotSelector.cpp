@@ -2,7 +2,8 @@
 
 #include <brandes/VertexInfoPivotSelector.h>
 
-#include <brandes/VertexInfo.h>
+#include <brandes/VertexInfoMatrix.h>
+#include <utility>
 #include <algorithm>
 #include <memory>
 #include <set>
@@ -14,45 +15,41 @@ using namespace fastbc::brandes;
 TEST_CASE("Pivot selection", "[brandes]")
 {
 	std::vector<double> globalBC = { 1,2,2,1.5,1,3 };
-	std::vector<std::shared_ptr<VertexInfo<int, double>>> verticesInfo(globalBC.size());
-	for (int i = 0; i < verticesInfo.size(); ++i)
-	{
-		verticesInfo[i] = std::make_shared<VertexInfo<int, double>>(3);
-	}
-	verticesInfo[0]->setBorderSPLength(0, 1.0f);
-	verticesInfo[0]->setBorderSPLength(1, 2.0f);
-	verticesInfo[0]->setBorderSPLength(2, 3.0f);
-	verticesInfo[0]->setBorderSPCount(0, 2);
-	verticesInfo[0]->setBorderSPCount(1, 1);
-	verticesInfo[0]->setBorderSPCount(2, 1);
-
-	verticesInfo[1]->setBorderSPLength(0, 2.0f);
-	verticesInfo[1]->setBorderSPLength(1, 1.0f);
-	verticesInfo[1]->setBorderSPLength(2, 3.0f);
-	verticesInfo[1]->setBorderSPCount(0, 2);
-	verticesInfo[1]->setBorderSPCount(1, 2);
-	verticesInfo[1]->setBorderSPCount(2, 1);
-
-	verticesInfo[2]->setBorderSPLength(0, 2.0f);
-	verticesInfo[2]->setBorderSPLength(1, 3.0f);
-	verticesInfo[2]->setBorderSPLength(2, 4.0f);
-	verticesInfo[2]->setBorderSPCount(0, 2);
-	verticesInfo[2]->setBorderSPCount(1, 1);
-	verticesInfo[2]->setBorderSPCount(2, 1);
-
-	verticesInfo[3]->setBorderSPLength(0, 4.0f);
-	verticesInfo[3]->setBorderSPLength(1, 3.0f);
-	verticesInfo[3]->setBorderSPLength(2, 5.0f);
-	verticesInfo[3]->setBorderSPCount(0, 2);
-	verticesInfo[3]->setBorderSPCount(1, 2);
-	verticesInfo[3]->setBorderSPCount(2, 1);
-
-	verticesInfo[4]->setBorderSPLength(0, 5.0f);
-	verticesInfo[4]->setBorderSPLength(1, 1.0f);
-	verticesInfo[4]->setBorderSPLength(2, 3.0f);
-	verticesInfo[4]->setBorderSPCount(0, 1);
-	verticesInfo[4]->setBorderSPCount(1, 1);
-	verticesInfo[4]->setBorderSPCount(2, 3);
+	VertexInfoMatrix<int, double> verticesInfo(5, 3);
+	verticesInfo.row(0).setBorderSPLength(0, 1.0f);
+	verticesInfo.row(0).setBorderSPLength(1, 2.0f);
+	verticesInfo.row(0).setBorderSPLength(2, 3.0f);
+	verticesInfo.row(0).setBorderSPCount(0, 2);
+	verticesInfo.row(0).setBorderSPCount(1, 1);
+	verticesInfo.row(0).setBorderSPCount(2, 1);
+
+	verticesInfo.row(1).setBorderSPLength(0, 2.0f);
+	verticesInfo.row(1).setBorderSPLength(1, 1.0f);
+	verticesInfo.row(1).setBorderSPLength(2, 3.0f);
+	verticesInfo.row(1).setBorderSPCount(0, 2);
+	verticesInfo.row(1).setBorderSPCount(1, 2);
+	verticesInfo.row(1).setBorderSPCount(2, 1);
+
+	verticesInfo.row(2).setBorderSPLength(0, 2.0f);
+	verticesInfo.row(2).setBorderSPLength(1, 3.0f);
+	verticesInfo.row(2).setBorderSPLength(2, 4.0f);
+	verticesInfo.row(2).setBorderSPCount(0, 2);
+	verticesInfo.row(2).setBorderSPCount(1, 1);
+	verticesInfo.row(2).setBorderSPCount(2, 1);
+
+	verticesInfo.row(3).setBorderSPLength(0, 4.0f);
+	verticesInfo.row(3).setBorderSPLength(1, 3.0f);
+	verticesInfo.row(3).setBorderSPLength(2, 5.0f);
+	verticesInfo.row(3).setBorderSPCount(0, 2);
+	verticesInfo.row(3).setBorderSPCount(1, 2);
+	verticesInfo.row(3).setBorderSPCount(2, 1);
+
+	verticesInfo.row(4).setBorderSPLength(0, 5.0f);
+	verticesInfo.row(4).setBorderSPLength(1, 1.0f);
+	verticesInfo.row(4).setBorderSPLength(2, 3.0f);
+	verticesInfo.row(4).setBorderSPCount(0, 1);
+	verticesInfo.row(4).setBorderSPCount(1, 1);
+	verticesInfo.row(4).setBorderSPCount(2, 3);
 
 	std::vector<int> vertices = { 0,1,2,3,4 };
 	std::set<int> borders = {};
@@ -72,4 +69,47 @@ TEST_CASE("Pivot selection", "[brandes]")
 	REQUIRE(pivots.second[0] == 2);
 	REQUIRE(pivots.second[1] == 2);
 	REQUIRE(pivots.second[2] == 1);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Pivot selection groups normalized classes without modifying vertex info", "[brandes]")
+{
+	// Vertices 3k, 3k+1 and 3k+2 share a class, with lengths shifted by a constant
+	const int classCount = 200;
+	const int vertexCount = 3 * classCount;
+	const int borderCount = 4;
+
+	std::vector<double> globalBC(vertexCount);
+	VertexInfoMatrix<int, double> verticesInfo(vertexCount, borderCount);
+	std::vector<int> vertices(vertexCount);
+	for (int v = 0; v < vertexCount; ++v)
+	{
+		int c = v / 3;
+		vertices[v] = v;
+		globalBC[v] = (v % 3 == 1) ? 0.5 : 1.0;
+
+		for (int b = 0; b < borderCount; ++b)
+		{
+			verticesInfo.row(v).setBorderSPLength(b, (c >> b) % 2 + (v % 3) * 0.5 + b * (c % 7));
+			verticesInfo.row(v).setBorderSPCount(b, 1 + c / 16);
+		}
+	}
+
+	VertexInfoMatrix<int, double> original(verticesInfo);
+
+	VertexInfoPivotSelector<int, double> ps;
+	std::pair<std::vector<int>, std::vector<int>> pivots =
+		ps.selectPivots(globalBC, verticesInfo, vertices, std::set<int>({ 0 }));
+
+	REQUIRE(pivots.first.size() == classCount);
+	for (int c = 0; c < classCount; ++c)
+	{
+		// Classes are sorted by first vertex, pivot has minimum BC
+		REQUIRE(pivots.first[c] == 3 * c + 1);
+		REQUIRE(pivots.second[c] == 3);
+	}
+
+	for (int v = 0; v < vertexCount; ++v)
+	{
+		REQUIRE(verticesInfo.row(v) == original.row(v));
+	}
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch.hpp>
+
+#include <brandes/VertexInfoProjection.h>
+
+#include <brandes/VertexInfoMatrix.h>
+#include <cmath>
+#include <random>
+
+using namespace fastbc::brandes;
+
+TEST_CASE("Vertex info random projection", "[brandes]")
+{
+	const int rows = 100;
+	const int borders = 200;
+	const int dimension = 64;
+
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<double> length(0.0, 100.0);
+	std::uniform_int_distribution<int> count(1, 10);
+
+	VertexInfoMatrix<int, double> matrix(rows, borders);
+	for (size_t r = 0; r < rows; ++r)
+	{
+		for (int b = 0; b < borders; ++b)
+		{
+			matrix.row(r).setBorderSPLength(b, length(rng));
+			matrix.row(r).setBorderSPCount(b, count(rng));
+		}
+	}
+
+	VertexInfoProjection<int, double> projection(borders, dimension, 3);
+	VertexInfoMatrix<int, double> projected = projection.project(matrix);
+
+	REQUIRE(projection.dimension() == dimension);
+	REQUIRE(projected.rows() == rows);
+	REQUIRE(projected.borders() == dimension);
+
+	SECTION("Projected vectors are stored as lengths")
+	{
+		for (size_t r = 0; r < rows; ++r)
+		{
+			for (int d = 0; d < dimension; ++d)
+			{
+				REQUIRE(projected.row(r).getBorderSPCount(d) == 0);
+			}
+		}
+	}
+
+	SECTION("Squared distances are preserved on average")
+	{
+		double error = 0;
+		for (size_t r = 1; r < rows; ++r)
+		{
+			double distance = matrix.row(r).squaredDistance(matrix.row(r - 1));
+			error += std::abs(projected.row(r).squaredDistance(projected.row(r - 1)) - distance) / distance;
+		}
+
+		REQUIRE(error / (rows - 1) < 0.25);
+	}
+
+	SECTION("Same seed gives same projection")
+	{
+		VertexInfoMatrix<int, double> again = VertexInfoProjection<int, double>(borders, dimension, 3).project(matrix);
+
+		for (size_t r = 0; r < rows; ++r)
+		{
+			REQUIRE(again.row(r) == projected.row(r));
+		}
+	}
+
+	SECTION("Invalid parameters")
+	{
+		REQUIRE_THROWS(VertexInfoProjection<int, double>(borders, 0));
+		REQUIRE_THROWS(VertexInfoProjection<int, double>(borders + 1, dimension).project(matrix));
+	}
+}
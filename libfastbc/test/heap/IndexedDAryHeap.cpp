@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include <heap/IndexedDAryHeap.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace fastbc::heap;
+
+TEST_CASE("Indexed d-ary heap push/pop", "[heap]")
+{
+	IndexedDAryHeap<int, double> heap(6);
+
+	REQUIRE(heap.empty());
+	REQUIRE(heap.capacity() == 6);
+
+	heap.push(3, 4.0);
+	heap.push(1, 2.0);
+	heap.push(5, 7.0);
+	heap.push(0, 2.0);
+
+	REQUIRE(heap.size() == 4);
+	REQUIRE(heap.contains(5));
+	REQUIRE_FALSE(heap.contains(2));
+
+	// Equal priorities are ordered by key
+	REQUIRE(heap.top() == 0);
+	REQUIRE(heap.topPriority() == 2.0);
+	REQUIRE(heap.pop() == 0);
+	REQUIRE(heap.pop() == 1);
+
+	SECTION("Decrease key")
+	{
+		heap.decrease(5, 1.0);
+		REQUIRE(heap.pop() == 5);
+		REQUIRE(heap.pop() == 3);
+		REQUIRE(heap.empty());
+	}
+
+	SECTION("Push or decrease")
+	{
+		heap.pushOrDecrease(2, 5.0);
+		heap.pushOrDecrease(3, 3.0);
+		REQUIRE(heap.size() == 3);
+		REQUIRE(heap.pop() == 3);
+		REQUIRE(heap.pop() == 2);
+		REQUIRE(heap.pop() == 5);
+	}
+
+	SECTION("Clear")
+	{
+		heap.clear();
+		REQUIRE(heap.empty());
+		REQUIRE_FALSE(heap.contains(3));
+		REQUIRE_NOTHROW(heap.resize(10));
+		REQUIRE(heap.capacity() == 10);
+	}
+}
+
+TEST_CASE("Indexed d-ary heap ordering", "[heap]")
+{
+	const int n = 1000;
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<double> priority(0.0, 100.0);
+
+	IndexedDAryHeap<int, double, 3> heap(n);
+	std::vector<std::pair<double, int>> expected(n);
+
+	for (int k = 0; k < n; ++k)
+	{
+		expected[k] = std::make_pair(priority(rng), k);
+		heap.push(k, expected[k].first);
+	}
+
+	// Decrease half of the priorities
+	for (int k = 0; k < n; k += 2)
+	{
+		expected[k].first /= 2;
+		heap.decrease(k, expected[k].first);
+	}
+
+	std::sort(expected.begin(), expected.end());
+
+	for (int i = 0; i < n; ++i)
+	{
+		REQUIRE(heap.topPriority() == expected[i].first);
+		REQUIRE(heap.pop() == expected[i].second);
+	}
+
+	REQUIRE(heap.empty());
+}
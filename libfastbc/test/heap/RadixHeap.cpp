@@ -0,0 +1,116 @@
+#include <catch2/catch.hpp>
+
+#include <heap/RadixHeap.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace fastbc::heap;
+
+TEST_CASE("Radix heap push/pop", "[heap]")
+{
+	RadixHeap<int, int> heap(6);
+
+	REQUIRE(heap.empty());
+	REQUIRE(heap.capacity() == 6);
+
+	heap.push(3, 4);
+	heap.push(1, 2);
+	heap.push(5, 9);
+	heap.push(0, 3);
+
+	REQUIRE(heap.size() == 4);
+	REQUIRE(heap.contains(5));
+	REQUIRE_FALSE(heap.contains(2));
+
+	REQUIRE(heap.top() == 1);
+	REQUIRE(heap.topPriority() == 2);
+	REQUIRE(heap.pop() == 1);
+	REQUIRE_FALSE(heap.contains(1));
+
+	SECTION("Decrease key")
+	{
+		heap.decrease(5, 3);
+		REQUIRE(heap.topPriority() == 3);
+		REQUIRE(heap.size() == 3);
+
+		// Equal priorities are both extracted before greater ones
+		int first = heap.pop();
+		int second = heap.pop();
+		REQUIRE(std::min(first, second) == 0);
+		REQUIRE(std::max(first, second) == 5);
+		REQUIRE(heap.pop() == 3);
+		REQUIRE(heap.empty());
+	}
+
+	SECTION("Push or decrease")
+	{
+		heap.pushOrDecrease(2, 7);
+		heap.pushOrDecrease(5, 6);
+		REQUIRE(heap.size() == 4);
+		REQUIRE(heap.pop() == 0);
+		REQUIRE(heap.pop() == 3);
+		REQUIRE(heap.pop() == 5);
+		REQUIRE(heap.pop() == 2);
+	}
+
+	SECTION("Clear")
+	{
+		heap.clear();
+		REQUIRE(heap.empty());
+		REQUIRE_FALSE(heap.contains(3));
+		REQUIRE_NOTHROW(heap.resize(10));
+		REQUIRE(heap.capacity() == 10);
+
+		// Priorities restart from zero after clear
+		heap.push(7, 0);
+		REQUIRE(heap.pop() == 7);
+	}
+}
+
+TEST_CASE("Radix heap monotone ordering", "[heap]")
+{
+	const int n = 1000;
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<long> priority(0, 1L << 40);
+	std::uniform_int_distribution<long> weight(1, 1000);
+
+	RadixHeap<int, long> heap(n);
+	std::vector<long> dist(n, -1);
+
+	// Simulate Dijkstra's usage: new priorities are never lower than last extracted one
+	for (int k = 0; k < n / 2; ++k)
+	{
+		dist[k] = priority(rng);
+		heap.push(k, dist[k]);
+	}
+
+	long last = 0;
+	int nextKey = n / 2;
+	while (!heap.empty())
+	{
+		REQUIRE(heap.topPriority() >= last);
+		last = heap.topPriority();
+		int k = heap.pop();
+		REQUIRE(dist[k] == last);
+
+		if (nextKey < n)
+		{
+			dist[nextKey] = last + weight(rng);
+			heap.push(nextKey, dist[nextKey]);
+			nextKey++;
+		}
+
+		// Decrease a random queued key towards the current minimum
+		int d = std::uniform_int_distribution<int>(0, n - 1)(rng);
+		if (heap.contains(d) && dist[d] > last)
+		{
+			dist[d] = last + (dist[d] - last) / 2;
+			heap.decrease(d, dist[d]);
+		}
+	}
+
+	REQUIRE(nextKey == n);
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch.hpp>
+
+#include <io/BinaryGraph.h>
+
+#include <DirectedWeightedGraph.h>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <memory>
+
+using namespace fastbc;
+
+TEST_CASE("Binary graph write/map", "[io]")
+{
+	std::ifstream dwgText("DWGtext.txt");
+	if (!dwgText.is_open())
+	{
+		throw std::runtime_error("Unable to read test graph file.");
+	}
+
+	DirectedWeightedGraph<int, double> textGraph(dwgText);
+	CSRGraph<int, double> graph(textGraph);
+
+	const std::string binaryPath = "DWGbinary.fbcg";
+	REQUIRE_NOTHROW(io::BinaryGraph<int, double>::write(graph, binaryPath));
+
+	REQUIRE(io::BinaryGraph<int, double>::isBinaryGraph(binaryPath));
+	REQUIRE_FALSE(io::BinaryGraph<int, double>::isBinaryGraph("DWGtext.txt"));
+
+	SECTION("Mapped graph matches written one")
+	{
+		std::shared_ptr<CSRGraph<int, double>> mapped;
+		REQUIRE_NOTHROW(mapped = io::BinaryGraph<int, double>::map(binaryPath));
+
+		REQUIRE(mapped->vertices().size() == graph.vertices().size());
+		REQUIRE(mapped->edges() == graph.edges());
+		REQUIRE(mapped->totalWeight() == graph.totalWeight());
+		REQUIRE_NOTHROW(io::BinaryGraph<int, double>::map(binaryPath, true));
+
+		for (int v = 0; v < (int)graph.vertices().size(); ++v)
+		{
+			REQUIRE(mapped->forwardStar(v).size() == graph.forwardStar(v).size());
+			REQUIRE(mapped->backwardStar(v).size() == graph.backwardStar(v).size());
+
+			for (const auto& [dest, weight] : graph.forwardStar(v))
+			{
+				REQUIRE(mapped->edge(v, dest) == weight);
+			}
+		}
+	}
+
+	SECTION("Mismatching types are rejected")
+	{
+		REQUIRE_THROWS(io::BinaryGraph<int, float>::map(binaryPath));
+		REQUIRE_THROWS(io::BinaryGraph<long, double>::map(binaryPath));
+	}
+
+	SECTION("Section out of file")
+	{
+		// Section position plus size would wrap around
+		std::fstream file(binaryPath, std::fstream::in | std::fstream::out | std::fstream::binary);
+		std::uint64_t position = ~(std::uint64_t)63;
+		file.seekp(56 + 2 * sizeof(std::uint64_t));
+		file.write(reinterpret_cast<const char*>(&position), sizeof(position));
+		file.close();
+
+		REQUIRE_THROWS(io::BinaryGraph<int, double>::map(binaryPath));
+	}
+
+	SECTION("Corrupted stars are rejected")
+	{
+		// Patch a value of given section in a copy of the snapshot
+		auto corrupt = [&binaryPath](int section, std::uint64_t index, auto value) {
+			std::fstream file(binaryPath, std::fstream::in | std::fstream::out | std::fstream::binary);
+			std::uint64_t position;
+			file.seekg(56 + section * sizeof(std::uint64_t));
+			file.read(reinterpret_cast<char*>(&position), sizeof(position));
+			file.seekp(position + index * sizeof(value));
+			file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		};
+
+		SECTION("Decreasing offsets")
+		{
+			corrupt(0, 1, (std::uint64_t)graph.edges());
+			REQUIRE_THROWS(io::BinaryGraph<int, double>::map(binaryPath, true));
+		}
+
+		SECTION("Out of range neighbor")
+		{
+			corrupt(4, 0, (int)graph.vertices().size());
+			REQUIRE_THROWS(io::BinaryGraph<int, double>::map(binaryPath, true));
+		}
+
+		SECTION("Negative neighbor")
+		{
+			corrupt(1, 0, -1);
+			REQUIRE_THROWS(io::BinaryGraph<int, double>::map(binaryPath, true));
+		}
+	}
+
+	SECTION("Integral total weight is exact")
+	{
+		// Above 2^53, a double cannot represent the total weight
+		DirectedWeightedGraph<int, long> heavyGraph;
+		heavyGraph.addEdge(0, 1, (1L << 53) + 1);
+		heavyGraph.addEdge(1, 0, 2);
+		heavyGraph.initVertices();
+		CSRGraph<int, long> heavy(heavyGraph);
+
+		io::BinaryGraph<int, long>::write(heavy, binaryPath);
+		REQUIRE(io::BinaryGraph<int, long>::map(binaryPath)->totalWeight() == (1L << 53) + 3);
+	}
+
+	SECTION("Text files are rejected")
+	{
+		REQUIRE_THROWS(io::BinaryGraph<int, double>::map("DWGtext.txt"));
+	}
+
+	std::remove(binaryPath.c_str());
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <io/EdgeListParser.h>
+
+#include <DirectedWeightedGraph.h>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace fastbc;
+
+TEST_CASE("Edge list parser matches stream loader", "[io]")
+{
+	std::ifstream dwgText("DWGtext.txt");
+	if (!dwgText.is_open())
+	{
+		throw std::runtime_error("Unable to read test graph file.");
+	}
+
+	DirectedWeightedGraph<int, double> textGraph(dwgText);
+
+	std::shared_ptr<CSRGraph<int, double>> graph;
+	REQUIRE_NOTHROW(graph = io::EdgeListParser<int, double>::parse("DWGtext.txt"));
+
+	REQUIRE(graph->vertices().size() == textGraph.vertices().size());
+	REQUIRE(graph->edges() == textGraph.edges());
+	REQUIRE(graph->totalWeight() == textGraph.totalWeight());
+
+	for (int v = 0; v < (int)graph->vertices().size(); ++v)
+	{
+		const auto fs = graph->forwardStar(v);
+		const auto textFs = textGraph.forwardStar(v);
+		REQUIRE(std::equal(fs.begin(), fs.end(), textFs.begin(), textFs.end()));
+
+		const auto bs = graph->backwardStar(v);
+		const auto textBs = textGraph.backwardStar(v);
+		REQUIRE(std::equal(bs.begin(), bs.end(), textBs.begin(), textBs.end()));
+	}
+}
+
+TEST_CASE("Edge list parser duplicates and formatting", "[io]")
+{
+	const std::string text = "0 1 2\n\n  2\t1 3.5\r\n0 1 1.5\n1 0 1\n2 1 0.5";
+
+	std::shared_ptr<CSRGraph<int, double>> graph =
+		io::EdgeListParser<int, double>::parse(text.data(), text.data() + text.size());
+
+	REQUIRE(graph->vertices().size() == 3);
+	REQUIRE(graph->edges() == 3);
+	REQUIRE(graph->edge(0, 1) == 3.5);
+	REQUIRE(graph->edge(2, 1) == 4.0);
+	REQUIRE(graph->edge(1, 0) == 1.0);
+	REQUIRE(graph->backwardStar(1).size() == 2);
+	REQUIRE(graph->backwardStar(1).find(2)->second == 4.0);
+	REQUIRE(graph->totalWeight() == 8.5);
+}
+
+TEST_CASE("Edge list parser errors", "[io]")
+{
+	const std::string negative = "0 1 2\n1 2 -1\n";
+	REQUIRE_THROWS_AS((io::EdgeListParser<int, double>::parse(negative.data(), negative.data() + negative.size())), 
+		std::invalid_argument);
+
+	const std::string malformed = "0 1 2\n1 x 1\n";
+	REQUIRE_THROWS_AS((io::EdgeListParser<int, double>::parse(malformed.data(), malformed.data() + malformed.size())), 
+		std::invalid_argument);
+
+	const std::string truncated = "0 1 2\n1 2\n";
+	REQUIRE_THROWS_AS((io::EdgeListParser<int, double>::parse(truncated.data(), truncated.data() + truncated.size())), 
+		std::invalid_argument);
+
+	// A missing field must not be taken from the next line
+	const std::string missing = "0 1\n2 3 4\n";
+	REQUIRE_THROWS_AS((io::EdgeListParser<int, double>::parse(missing.data(), missing.data() + missing.size())), 
+		std::invalid_argument);
+
+	const std::string extra = "0 1 2 3\n";
+	REQUIRE_THROWS_AS((io::EdgeListParser<int, double>::parse(extra.data(), extra.data() + extra.size())), 
+		std::invalid_argument);
+
+	const std::string trailing = "0 1 2 \t\r\n1 2 1\t\n";
+	REQUIRE(io::EdgeListParser<int, double>::parse(trailing.data(), trailing.data() + trailing.size())->edges() == 2);
+
+	REQUIRE(io::EdgeListParser<int, double>::parse(nullptr, nullptr)->vertices().empty());
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch.hpp>
+
+#include <kmeans/HamerlyKMeans.h>
+
+#include <brandes/VertexInfoMatrix.h>
+#include <kmeans/PlusPlusKMeans.h>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace fastbc;
+
+TEST_CASE("Hamerly kmeans matches plain kmeans", "[kmeans]")
+{
+	const int rows = 2000;
+	const int borders = 6;
+
+	// Random vertex info around a few well separated groups
+	std::mt19937 rng(17);
+	std::uniform_int_distribution<int> group(0, 9);
+	std::uniform_real_distribution<double> noise(0.0, 4.0);
+	std::uniform_int_distribution<int> count(1, 3);
+
+	brandes::VertexInfoMatrix<int, double> vertexInfo(rows, borders);
+	for (int r = 0; r < rows; ++r)
+	{
+		int g = group(rng);
+		for (int b = 0; b < borders; ++b)
+		{
+			vertexInfo.row(r).setBorderSPLength(b, 20.0 * ((g + b) % 10) + noise(rng));
+			vertexInfo.row(r).setBorderSPCount(b, count(rng));
+		}
+	}
+
+	// K-means on a subset of rows
+	std::vector<int> vertices;
+	std::vector<int> weights;
+	for (int r = 0; r < rows; r += 2)
+	{
+		vertices.push_back(r);
+		weights.push_back(1 + r % 5);
+	}
+
+	kmeans::PlusPlusKMeans<int, double> plain;
+	kmeans::HamerlyKMeans<int, double> hamerly;
+
+	for (int k : { 1, 7, 40 })
+	{
+		auto expected = plain.computeCentroids(k, vertices, weights, vertexInfo);
+		auto result = hamerly.computeCentroids(k, vertices, weights, vertexInfo);
+
+		REQUIRE(result.first == expected.first);
+		REQUIRE(result.second == expected.second);
+		REQUIRE(std::accumulate(result.second.begin(), result.second.end(), 0) ==
+			std::accumulate(weights.begin(), weights.end(), 0));
+	}
+}
@@ -0,0 +1,101 @@
+#include <catch2/catch.hpp>
+
+#include <kmeans/MiniBatchKMeans.h>
+
+#include <algorithm>
+#include <brandes/VertexInfoMatrix.h>
+#include <kmeans/HamerlyKMeans.h>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace fastbc;
+
+// Weighted squared distance of each vertex from its nearest centroid
+static double inertia(
+	const std::vector<int>& centroids,
+	const std::vector<int>& vertices,
+	const std::vector<int>& weights,
+	const brandes::VertexInfoMatrix<int, double>& vertexInfo)
+{
+	double sum = 0;
+	for (size_t v = 0; v < vertices.size(); ++v)
+	{
+		double minDist = std::numeric_limits<double>::max();
+		for (int c : centroids)
+		{
+			minDist = std::min(minDist, vertexInfo.row(c).squaredDistance(vertexInfo.row(vertices[v])));
+		}
+		sum += weights[v] * minDist;
+	}
+
+	return sum;
+}
+
+TEST_CASE("Mini-batch kmeans centroids", "[kmeans]")
+{
+	const int rows = 4000;
+	const int borders = 6;
+
+	// Random vertex info around a few well separated groups
+	std::mt19937 rng(23);
+	std::uniform_int_distribution<int> group(0, 9);
+	std::uniform_real_distribution<double> noise(0.0, 4.0);
+	std::uniform_int_distribution<int> count(1, 3);
+
+	brandes::VertexInfoMatrix<int, double> vertexInfo(rows, borders);
+	for (int r = 0; r < rows; ++r)
+	{
+		int g = group(rng);
+		for (int b = 0; b < borders; ++b)
+		{
+			vertexInfo.row(r).setBorderSPLength(b, 20.0 * ((g * 3 + b) % 10) + noise(rng));
+			vertexInfo.row(r).setBorderSPCount(b, count(rng));
+		}
+	}
+
+	std::vector<int> vertices;
+	std::vector<int> weights;
+	for (int r = 0; r < rows; r += 2)
+	{
+		vertices.push_back(r);
+		weights.push_back(1 + r % 5);
+	}
+
+	REQUIRE_THROWS(kmeans::MiniBatchKMeans<int, double>(0));
+
+	kmeans::MiniBatchKMeans<int, double> miniBatch(128, 5);
+	kmeans::HamerlyKMeans<int, double> fullBatch;
+
+	for (int k : { 1, 10, 40 })
+	{
+		auto result = miniBatch.computeCentroids(k, vertices, weights, vertexInfo);
+
+		SECTION("Centroids are weighted input vertices, k = " + std::to_string(k))
+		{
+			REQUIRE(result.first.size() == (size_t)k);
+			REQUIRE(result.second.size() == (size_t)k);
+			for (int c : result.first)
+			{
+				REQUIRE(std::find(vertices.begin(), vertices.end(), c) != vertices.end());
+			}
+			REQUIRE(std::accumulate(result.second.begin(), result.second.end(), 0) ==
+				std::accumulate(weights.begin(), weights.end(), 0));
+		}
+
+		SECTION("Same seed gives same centroids, k = " + std::to_string(k))
+		{
+			REQUIRE(miniBatch.computeCentroids(k, vertices, weights, vertexInfo) == result);
+		}
+
+		SECTION("Inertia close to full batch kmeans, k = " + std::to_string(k))
+		{
+			auto expected = fullBatch.computeCentroids(k, vertices, weights, vertexInfo);
+
+			REQUIRE(inertia(result.first, vertices, weights, vertexInfo) <=
+				1.2 * inertia(expected.first, vertices, weights, vertexInfo));
+		}
+	}
+}
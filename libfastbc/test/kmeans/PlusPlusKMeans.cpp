@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include <kmeans/PlusPlusKMeans.h>
+
+#include <algorithm>
+#include <brandes/VertexInfoMatrix.h>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace fastbc;
+
+TEST_CASE("Kmeans parallel initialization", "[kmeans]")
+{
+	typedef kmeans::PlusPlusKMeans<int, double>::Initialization Initialization;
+
+	const int rows = 3000;
+	const int borders = 5;
+	const int groups = 12;
+
+	// Random vertex info around well separated groups
+	std::mt19937 rng(31);
+	std::uniform_int_distribution<int> group(0, groups - 1);
+	std::uniform_real_distribution<double> noise(0.0, 3.0);
+
+	brandes::VertexInfoMatrix<int, double> vertexInfo(rows, borders);
+	std::vector<int> rowGroup(rows);
+	for (int r = 0; r < rows; ++r)
+	{
+		rowGroup[r] = group(rng);
+		for (int b = 0; b < borders; ++b)
+		{
+			vertexInfo.row(r).setBorderSPLength(b, 50.0 * ((rowGroup[r] >> b) & 1) + 25.0 * (rowGroup[r] % 3) + noise(rng));
+			vertexInfo.row(r).setBorderSPCount(b, 1);
+		}
+	}
+
+	std::vector<int> vertices(rows);
+	std::iota(vertices.begin(), vertices.end(), 0);
+	std::vector<int> weights(rows, 1);
+
+	// Weighted squared distance of each vertex from its nearest centroid
+	auto inertia = [&](const std::vector<int>& centroids)
+	{
+		double sum = 0;
+		for (int v : vertices)
+		{
+			double minDist = std::numeric_limits<double>::max();
+			for (int c : centroids)
+			{
+				minDist = std::min(minDist, vertexInfo.row(c).squaredDistance(vertexInfo.row(v)));
+			}
+			sum += minDist;
+		}
+
+		return sum;
+	};
+
+	kmeans::PlusPlusKMeans<int, double> plusPlus(Initialization::PLUSPLUS);
+	kmeans::PlusPlusKMeans<int, double> parallel(Initialization::PARALLEL, 7);
+
+	SECTION("One centroid in each group")
+	{
+		auto result = parallel.computeCentroids(groups, vertices, weights, vertexInfo);
+
+		REQUIRE(result.first.size() == groups);
+		std::set<int> centroidGroups;
+		for (int c : result.first)
+		{
+			centroidGroups.insert(rowGroup[c]);
+		}
+		REQUIRE(centroidGroups.size() == groups);
+		REQUIRE(std::accumulate(result.second.begin(), result.second.end(), 0) == rows);
+	}
+
+	SECTION("Results are repeatable and close to sequential initialization")
+	{
+		for (int k : { 1, 12, 60, 300 })
+		{
+			auto result = parallel.computeCentroids(k, vertices, weights, vertexInfo);
+			auto expected = plusPlus.computeCentroids(k, vertices, weights, vertexInfo);
+
+			REQUIRE(result.first.size() == (size_t)k);
+			REQUIRE(parallel.computeCentroids(k, vertices, weights, vertexInfo) == result);
+			REQUIRE(inertia(result.first) <= 1.2 * inertia(expected.first));
+		}
+	}
+
+	SECTION("More centroids than distinct vertices")
+	{
+		std::vector<int> few = { 0, 1, 2 };
+		auto result = parallel.computeCentroids(5, few, { 1, 1, 1 }, vertexInfo);
+
+		// Each vertex is its own centroid, with no duplicated one
+		REQUIRE(result.first.size() == 3);
+		REQUIRE(std::set<int>(result.first.begin(), result.first.end()).size() == 3);
+		REQUIRE(std::accumulate(result.second.begin(), result.second.end(), 0) == 3);
+	}
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+
+#include <louvain/LouvainGraph.h>
+
+#include <CSRGraph.h>
+#include <DirectedWeightedGraph.h>
+#include <exception>
+#include <fstream>
+#include <memory>
+
+using namespace fastbc::louvain;
+
+TEST_CASE("Louvain graph from CSR and adjacency graphs", "[louvain]")
+{
+	std::ifstream dwgText("DWGtext.txt");
+	if (!dwgText.is_open())
+	{
+		throw std::runtime_error("Unable to read test graph file.");
+	}
+
+	auto dwg = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>(dwgText);
+	auto csr = std::make_shared<fastbc::CSRGraph<int, double>>(*dwg);
+
+	LouvainGraph<int, double> fromDWG(dwg);
+	LouvainGraph<int, double> fromCSR(csr);
+
+	// A CSR graph is referenced without copying its arrays
+	REQUIRE(fromCSR.outlinks == csr->outTargets());
+	REQUIRE(fromCSR.inlinks == csr->inSources());
+
+	REQUIRE(fromCSR.nb_nodes == 9);
+	REQUIRE(fromCSR.nb_links == 16);
+	REQUIRE(fromCSR.total_weight == dwg->totalWeight());
+
+	REQUIRE(fromDWG.nb_nodes == fromCSR.nb_nodes);
+	REQUIRE(fromDWG.nb_links == fromCSR.nb_links);
+	REQUIRE(fromDWG.total_weight == fromCSR.total_weight);
+
+	for (int node = 0; node < (int)fromCSR.nb_nodes; ++node)
+	{
+		REQUIRE(fromDWG.weighted_out_degree(node) == fromCSR.weighted_out_degree(node));
+		REQUIRE(fromDWG.weighted_in_degree(node) == fromCSR.weighted_in_degree(node));
+		REQUIRE(fromDWG.weighted_selfloops(node) == fromCSR.weighted_selfloops(node));
+
+		auto fs = dwg->forwardStar(node);
+		REQUIRE(fromDWG.nb_out_neighbors(node) == fromCSR.nb_out_neighbors(node));
+		REQUIRE(fromDWG.nb_out_neighbors(node) == fs.size());
+		auto dwgOut = fromDWG.out_neighbors(node), csrOut = fromCSR.out_neighbors(node);
+		for (unsigned int i = 0; i < fromCSR.nb_out_neighbors(node); ++i)
+		{
+			REQUIRE(dwgOut.first[i] == csrOut.first[i]);
+			REQUIRE(dwgOut.second[i] == csrOut.second[i]);
+			REQUIRE(fs.vertices()[i] == csrOut.first[i]);
+			REQUIRE(fs.weights()[i] == csrOut.second[i]);
+		}
+
+		auto bs = dwg->backwardStar(node);
+		REQUIRE(fromDWG.nb_in_neighbors(node) == fromCSR.nb_in_neighbors(node));
+		REQUIRE(fromDWG.nb_in_neighbors(node) == bs.size());
+		auto dwgIn = fromDWG.in_neighbors(node), csrIn = fromCSR.in_neighbors(node);
+		for (unsigned int i = 0; i < fromCSR.nb_in_neighbors(node); ++i)
+		{
+			REQUIRE(dwgIn.first[i] == csrIn.first[i]);
+			REQUIRE(dwgIn.second[i] == csrIn.second[i]);
+			REQUIRE(bs.vertices()[i] == csrIn.first[i]);
+			REQUIRE(bs.weights()[i] == csrIn.second[i]);
+		}
+	}
+}
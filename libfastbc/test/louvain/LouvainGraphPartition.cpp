@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+
+#include <louvain/LouvainGraphPartition.h>
+
+#include <DirectedWeightedGraph.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace fastbc::louvain;
+
+// Symmetric graph of groups of vertices densely linked inside, sparsely across
+static std::shared_ptr<fastbc::DirectedWeightedGraph<int, double>> plantedGraph(
+	int groups, int groupSize, unsigned int seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> p(0.0, 1.0);
+	std::uniform_real_distribution<double> weight(0.5, 2.0);
+
+	auto graph = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	int n = groups * groupSize;
+	for (int u = 0; u < n; ++u)
+	{
+		for (int v = u + 1; v < n; ++v)
+		{
+			if (p(rng) < (u / groupSize == v / groupSize ? 0.6 : 0.02))
+			{
+				double w = weight(rng);
+				graph->addEdge(u, v, w);
+				graph->addEdge(v, u, w);
+			}
+		}
+	}
+	graph->initVertices();
+
+	return graph;
+}
+
+// Directed modularity of given communities, computed from scratch
+static double modularity(const LouvainGraph<int, double>& g, const std::vector<std::vector<int>>& communities)
+{
+	std::vector<int> n2c(g.nb_nodes, -1);
+	for (size_t c = 0; c < communities.size(); ++c)
+	{
+		for (const auto& v : communities[c])
+		{
+			n2c[v] = c;
+		}
+	}
+
+	double m = g.total_weight, inside = 0;
+	std::vector<double> out(communities.size(), 0), in(communities.size(), 0);
+	for (unsigned int u = 0; u < g.nb_nodes; ++u)
+	{
+		auto links = g.out_neighbors(u);
+		for (unsigned int i = 0; i < g.nb_out_neighbors(u); ++i)
+		{
+			int v = links.first[i];
+			double w = links.second[i];
+			out[n2c[u]] += w;
+			in[n2c[v]] += w;
+			if (n2c[u] == n2c[v])
+			{
+				inside += w;
+			}
+		}
+	}
+
+	double q = inside / m;
+	for (size_t c = 0; c < communities.size(); ++c)
+	{
+		q -= out[c] * in[c] / (m * m);
+	}
+
+	return q;
+}
+
+TEST_CASE("Louvain partition with parallel moves and active pruning", "[louvain]")
+{
+	auto graph = plantedGraph(6, 15, 7);
+	LouvainGraph<int, double> g(graph);
+
+	for (bool parallelMoves : { false, true })
+	{
+		for (bool activePruning : { false, true })
+		{
+			LouvainGraphPartition<int, double> lp(std::set<std::mt19937::result_type>({ 1, 2, 3 }),
+				0.01, parallelMoves, activePruning);
+			std::vector<std::vector<int>> communities = lp.partitionGraph(graph);
+
+			// Each vertex is in exactly one non empty community
+			std::vector<int> seen(g.nb_nodes, 0);
+			for (const auto& community : communities)
+			{
+				REQUIRE(!community.empty());
+				for (const auto& v : community)
+				{
+					REQUIRE(v >= 0);
+					REQUIRE(v < (int)g.nb_nodes);
+					++seen[v];
+				}
+			}
+			REQUIRE(std::count(seen.begin(), seen.end(), 1) == (long)g.nb_nodes);
+
+			REQUIRE(modularity(g, communities) >= 0);
+		}
+	}
+}
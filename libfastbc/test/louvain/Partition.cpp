@@ -0,0 +1,155 @@
+#include <catch2/catch.hpp>
+
+#include <louvain/Partition.h>
+
+#include <DirectedWeightedGraph.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace fastbc::louvain;
+
+// Same number of nodes and same in and out links of each node, in the same order
+static void requireSameGraph(const LouvainGraph<int, double>& a, const LouvainGraph<int, double>& b)
+{
+	REQUIRE(a.nb_nodes == b.nb_nodes);
+	REQUIRE(a.nb_links == b.nb_links);
+	REQUIRE(a.total_weight == b.total_weight);
+
+	for (unsigned int node = 0; node < a.nb_nodes; ++node)
+	{
+		REQUIRE(a.nb_out_neighbors(node) == b.nb_out_neighbors(node));
+		auto aOut = a.out_neighbors(node), bOut = b.out_neighbors(node);
+		for (unsigned int i = 0; i < a.nb_out_neighbors(node); ++i)
+		{
+			REQUIRE(aOut.first[i] == bOut.first[i]);
+			REQUIRE(aOut.second[i] == bOut.second[i]);
+		}
+
+		REQUIRE(a.nb_in_neighbors(node) == b.nb_in_neighbors(node));
+		auto aIn = a.in_neighbors(node), bIn = b.in_neighbors(node);
+		for (unsigned int i = 0; i < a.nb_in_neighbors(node); ++i)
+		{
+			REQUIRE(aIn.first[i] == bIn.first[i]);
+			REQUIRE(aIn.second[i] == bIn.second[i]);
+		}
+	}
+}
+
+// Directed modularity of the partition, computed from scratch
+static double sweepModularity(const Partition<int, double>& p)
+{
+	const LouvainGraph<int, double>& g = *p.g;
+	double m = g.total_weight, inside = 0;
+	std::vector<double> out(p.size, 0), in(p.size, 0);
+	for (int u = 0; u < p.size; ++u)
+	{
+		auto links = g.out_neighbors(u);
+		for (unsigned int i = 0; i < g.nb_out_neighbors(u); ++i)
+		{
+			int v = links.first[i];
+			double w = links.second[i];
+			out[p.n2c[u]] += w;
+			in[p.n2c[v]] += w;
+			if (p.n2c[u] == p.n2c[v])
+			{
+				inside += w;
+			}
+		}
+	}
+
+	double q = inside / m;
+	for (int c = 0; c < p.size; ++c)
+	{
+		q -= out[c] * in[c] / (m * m);
+	}
+
+	return q;
+}
+
+TEST_CASE("Louvain partition to coarse graph", "[louvain]")
+{
+	auto graph = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	graph->addEdge(0, 1, 1.0);
+	graph->addEdge(1, 2, 2.0);
+	graph->addEdge(2, 0, 3.0);
+	graph->addEdge(0, 3, 4.0);
+	graph->addEdge(3, 4, 5.0);
+	graph->addEdge(4, 3, 1.0);
+	graph->addEdge(4, 5, 2.0);
+	graph->addEdge(5, 0, 1.5);
+	graph->addEdge(2, 5, 0.5);
+	graph->initVertices();
+
+	// Communities { 0, 1, 2 }, { 3, 4 } and { 5 }
+	Partition<int, double> p(std::make_shared<const LouvainGraph<int, double>>(graph), 0.01);
+	p.remove(1);
+	p.insert(1, 0);
+	p.remove(2);
+	p.insert(2, 0);
+	p.remove(4);
+	p.insert(4, 3);
+
+	// Links inside a community become a self loop, parallel links are merged
+	auto coarse = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	coarse->addEdge(0, 0, 6.0);
+	coarse->addEdge(0, 1, 4.0);
+	coarse->addEdge(0, 2, 0.5);
+	coarse->addEdge(1, 1, 6.0);
+	coarse->addEdge(1, 2, 2.0);
+	coarse->addEdge(2, 0, 1.5);
+	coarse->initVertices();
+
+	requireSameGraph(p.partition2graph(), LouvainGraph<int, double>(coarse));
+}
+
+TEST_CASE("Louvain tracked modularity with parallel moves and active pruning", "[louvain]")
+{
+	// Directed random graph, in and out degrees of most vertices differ
+	const int n = 300;
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> vertex(0, n - 1);
+	std::uniform_real_distribution<double> weight(0.5, 2.0);
+
+	auto graph = std::make_shared<fastbc::DirectedWeightedGraph<int, double>>();
+	for (int u = 0; u < n; ++u)
+	{
+		// One way ring links keep every vertex connected
+		graph->addEdge(u, (u + 1) % n, weight(rng));
+	}
+	for (int e = 0; e < 3 * n; ++e)
+	{
+		int u = vertex(rng), v = vertex(rng);
+		if (u != v)
+		{
+			graph->addEdge(u, v, weight(rng));
+		}
+	}
+	graph->initVertices();
+
+	auto g = std::make_shared<const LouvainGraph<int, double>>(graph);
+
+	for (bool parallelMoves : { false, true })
+	{
+		for (bool activePruning : { false, true })
+		{
+			Partition<int, double> p(g, 0.000001, activePruning);
+			REQUIRE(p.modularity() == Approx(sweepModularity(p)).margin(1e-9));
+
+			std::mt19937 seed(5);
+			REQUIRE((parallelMoves ? p.one_level_parallel(seed) : p.one_level(seed)));
+
+			// Every vertex is in a valid community
+			for (int node = 0; node < p.size; ++node)
+			{
+				REQUIRE(p.n2c[node] >= 0);
+				REQUIRE(p.n2c[node] < p.size);
+			}
+
+			// Sequential and parallel moves track the modularity of a full sweep
+			double swept = sweepModularity(p);
+			REQUIRE(p.modularity() == Approx(swept).margin(1e-9));
+			REQUIRE(swept >= 0);
+		}
+	}
+}
@@ -5,14 +5,19 @@
 #define FASTBC_BRANDES_ENABLE_PIVOT_BORDER
 #define FASTBC_BRANDES_CLUSTERED_IGNORE_UNCONNECTED
 
-#include <DirectedWeightedGraph.h>
+#include <CSRGraph.h>
+#include <brandes/BFSBrandesBC.h>
+#include <brandes/BFSSSBrandesBC.h>
 #include <brandes/ClusteredBrandesBC.h>
 #include <brandes/DijkstraClusterEvaluator.h>
 #include <brandes/DijkstraSSBrandesBC.h>
 #include <brandes/ExactBrandesBC.h>
 #include <brandes/KMeansPivotSelector.h>
 #include <brandes/VertexInfoPivotSelector.h>
-#include <kmeans/PlusPlusKMeans.h>
+#include <io/BinaryGraph.h>
+#include <io/EdgeListParser.h>
+#include <kmeans/HamerlyKMeans.h>
+#include <kmeans/MiniBatchKMeans.h>
 #include <louvain/LouvainGraphPartition.h>
 
 #include <chrono>
@@ -37,17 +42,36 @@
 #define FASTBC_SPDLOG_FORMAT_DEBUG	"[%H:%M:%S.%f] %^[%=9l]%$ [%=7t] [%!]\n\t%v"
 #define FASTBC_SPDLOG_FORMAT		"%^[%=9l]%$ %v"
 
+typedef fastbc::CSRGraph<FASTBC_V_TYPE, FASTBC_W_TYPE> Graph;
+typedef fastbc::io::BinaryGraph<FASTBC_V_TYPE, FASTBC_W_TYPE> BinaryGraph;
+
+/**
+ *	@brief Load graph from a binary snapshot (memory mapped) or from a text edge list
+ */
+static std::shared_ptr<Graph> loadGraph(const std::string& graphPath, bool validateGraph)
+{
+	if (BinaryGraph::isBinaryGraph(graphPath))
+	{
+		SPDLOG_INFO("Mapping binary graph \"{}\"", graphPath);
+		return BinaryGraph::map(graphPath, validateGraph);
+	}
+
+	// Parse text edge list in parallel
+	return fastbc::io::EdgeListParser<FASTBC_V_TYPE, FASTBC_W_TYPE>::parse(graphPath);
+}
+
 int main(int argc, char **argv)
 {
 	/*
 	 *	Program options 
 	 */
-	std::string edgeListPath, outBCPath, louvainSeed, loggerLevel;
-	int threads, louvainExecutors;
+	std::string edgeListPath, binaryGraphPath, outBCPath, louvainSeed, loggerLevel, kmeansInit;
+	int threads, louvainExecutors, kmeansBatch, kmeansIterations, kmeansProjection;
 	double louvainPrecision, kFrac;
-	bool exactBC;
+	bool exactBC, louvainParallel, louvainPruning, validateGraph;
 
-	popl::OptionParser op("Usage: fastbc [ options ] <edge_list_path>");
+	popl::OptionParser op("Usage: fastbc [ options ] <edge_list_path>\n"
+		"       fastbc convert <edge_list_path> <binary_graph_path>");
 	auto ls = op.add<popl::Value<std::string>, popl::Attribute::optional>(
 		"s", "louvain-seeds",
 		"Seeds to be used by each parallel louvain execution",
@@ -63,14 +87,45 @@ int main(int argc, char **argv)
 		"Minimum precision value for louvain algorithm",
 		0.01,
 		&louvainPrecision);
+	op.add<popl::Switch, popl::Attribute::optional>(
+		"", "louvain-parallel",
+		"Move vertices concurrently inside each louvain instance",
+		&louvainParallel);
+	op.add<popl::Switch, popl::Attribute::optional>(
+		"", "louvain-pruning",
+		"Only revisit vertices with moved neighbors in later louvain passes",
+		&louvainPruning);
 	auto kf = op.add<popl::Value<double>, popl::Attribute::optional>(
 		"k", "kfrac",
 		"Topological classes aggregation factor (0-1). Enables 2-Clustered Brandes algorithm");
 	kf->assign_to(&kFrac);
+	auto kb = op.add<popl::Value<int>, popl::Attribute::optional>(
+		"b", "kmeans-batch",
+		"Mini-batch size for topological classes aggregation. Enables mini-batch kmeans");
+	kb->assign_to(&kmeansBatch);
+	op.add<popl::Value<int>, popl::Attribute::optional>(
+		"i", "kmeans-iterations",
+		"Maximum kmeans iterations for topological classes aggregation",
+		100,
+		&kmeansIterations);
+	op.add<popl::Value<std::string>, popl::Attribute::optional>(
+		"", "kmeans-init",
+		"Kmeans initialization for topological classes aggregation (plusplus|parallel)",
+		"plusplus",
+		&kmeansInit);
+	op.add<popl::Value<int>, popl::Attribute::optional>(
+		"", "kmeans-projection",
+		"Random projection dimension of topological classes info before kmeans (0 disables projection)",
+		0,
+		&kmeansProjection);
 	op.add<popl::Switch, popl::Attribute::optional>(
 		"", "exact",
 		"Force exact betweenness computation (very long time)",
 		&exactBC);
+	op.add<popl::Switch, popl::Attribute::optional>(
+		"", "validate-graph",
+		"Check every star of a binary graph before use, for snapshots not written by convert",
+		&validateGraph);
 	auto nt = op.add<popl::Value<int>, popl::Attribute::optional>(
 		"t", "threads",
 		"Maximum number of threads used in parallel computation");
@@ -97,7 +152,19 @@ int main(int argc, char **argv)
 	}
 
 	// Check if input file has been given
-	if (op.non_option_args().size() != 1)
+	bool convertGraph = !op.non_option_args().empty() && op.non_option_args().front() == "convert";
+	if (convertGraph)
+	{
+		if (op.non_option_args().size() != 3)
+		{
+			std::cout << "Missing input or output file path" << "\n\n" << op.help();
+			return -1;
+		}
+
+		edgeListPath = op.non_option_args()[1];
+		binaryGraphPath = op.non_option_args()[2];
+	}
+	else if (op.non_option_args().size() != 1)
 	{
 		std::cout << "Missing input file path" << "\n\n" << op.help();
 		return -1;
@@ -120,6 +187,25 @@ int main(int argc, char **argv)
 	}
 	spdlog::set_level(log_level);
 
+	// Convert given edge list to a binary graph snapshot
+	if (convertGraph)
+	{
+		try {
+			std::shared_ptr<Graph> graph = loadGraph(edgeListPath, validateGraph);
+			BinaryGraph::write(*graph, binaryGraphPath);
+
+			SPDLOG_INFO("Graph with {} vertices and {} edges written to \"{}\"", 
+				graph->vertices().size(), graph->edges(), binaryGraphPath);
+		}
+		catch (std::exception& e)
+		{
+			SPDLOG_CRITICAL("{}", e.what());
+			return -1;
+		}
+
+		return 0;
+	}
+
 	// Check bc output file
 	std::ifstream outFileTest(outBCPath, std::ifstream::in);
 	if (outFileTest.good())
@@ -180,6 +266,36 @@ int main(int argc, char **argv)
 		}
 	}
 
+	// Check kmeans parameters
+	if (kb->is_set() && (!kf->is_set() || kmeansBatch <= 0))
+	{
+		SPDLOG_CRITICAL("Kmeans batch must be a positive value and requires kfrac to be set.");
+		return -1;
+	}
+
+	if (kmeansIterations <= 0)
+	{
+		SPDLOG_CRITICAL("Kmeans iterations must be a positive value.");
+		return -1;
+	}
+
+	if (kmeansProjection < 0)
+	{
+		SPDLOG_CRITICAL("Kmeans projection dimension must not be negative.");
+		return -1;
+	}
+
+	auto kmeansInitialization = fastbc::kmeans::PlusPlusKMeans<FASTBC_V_TYPE, FASTBC_W_TYPE>::Initialization::PLUSPLUS;
+	if (kmeansInit == "parallel")
+	{
+		kmeansInitialization = fastbc::kmeans::PlusPlusKMeans<FASTBC_V_TYPE, FASTBC_W_TYPE>::Initialization::PARALLEL;
+	}
+	else if (kmeansInit != "plusplus")
+	{
+		SPDLOG_CRITICAL("Unknown kmeans initialization \"{}\".", kmeansInit);
+		return -1;
+	}
+
 	if(nt->is_set())
 	{
 		SPDLOG_INFO("Maximum number of threads set to {}", threads);
@@ -196,34 +312,48 @@ int main(int argc, char **argv)
 	/*
 	 *	Program initialization
 	 */
-	// Open graph text file
-	std::ifstream graphTextFile(edgeListPath);
-	if (!graphTextFile.is_open())
+	// Initialize graph object from binary snapshot or text edge list
+	std::shared_ptr<Graph> graph;
+	try {
+		graph = loadGraph(edgeListPath, validateGraph);
+	}
+	catch (std::exception& e)
 	{
-		SPDLOG_CRITICAL("There was an error opening given edge list file path.");
+		SPDLOG_CRITICAL("{}", e.what());
 		return -1;
 	}
 
-	// Initialize graph object with loaded text file
-	std::shared_ptr<fastbc::IGraph<FASTBC_V_TYPE, FASTBC_W_TYPE>> graph =
-		std::make_shared<fastbc::DirectedWeightedGraph<FASTBC_V_TYPE, FASTBC_W_TYPE>>(graphTextFile);
-
 	// Print some information about loaded graph
 	SPDLOG_INFO("Loaded graph contains {} vertices and {} edges", graph->vertices().size(), graph->edges());
 
+	// Unweighted graphs (all edges with same weight) use breadth first shortest paths
+	bool uniformWeights = graph->uniformWeights();
+	if (uniformWeights)
+	{
+		SPDLOG_INFO("All edges have the same weight, using BFS shortest paths");
+	}
+
 	std::shared_ptr<fastbc::brandes::IBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>> brandesBC;
 	if(exactBC)
 	{
 		SPDLOG_INFO("Algorithm: exact Brandes' betweenness centrality");
-		brandesBC = 
-			std::make_shared<fastbc::brandes::ExactBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>>();
+		if (uniformWeights)
+		{
+			brandesBC =
+				std::make_shared<fastbc::brandes::BFSBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>>();
+		}
+		else
+		{
+			brandesBC =
+				std::make_shared<fastbc::brandes::ExactBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>>();
+		}
 	}
 	else
 	{
 		/* Louvain community detector */
 		std::shared_ptr<fastbc::IGraphPartition<FASTBC_V_TYPE, FASTBC_W_TYPE>> louvainEvaluator =
 			std::make_shared<fastbc::louvain::LouvainGraphPartition<FASTBC_V_TYPE, FASTBC_W_TYPE>>(
-				seed, louvainPrecision);
+				seed, louvainPrecision, louvainParallel, louvainPruning);
 
 		/* Brandes cluster evaluator */
 		std::shared_ptr<fastbc::brandes::IClusterEvaluator<FASTBC_V_TYPE, FASTBC_W_TYPE>> clusterEvaluator =
@@ -234,14 +364,31 @@ int main(int argc, char **argv)
 		if (kf->is_set())
 		{
 			SPDLOG_INFO("Algorithm: 2-clustered Brandes' betweenness centrality");
+
+			// Full batch or mini-batch kmeans
+			std::shared_ptr<fastbc::kmeans::IKMeans<FASTBC_V_TYPE, FASTBC_W_TYPE>> kmeans;
+			if (kb->is_set())
+			{
+				SPDLOG_INFO("Topological classes aggregation: mini-batch kmeans, batch size {}", kmeansBatch);
+				kmeans = std::make_shared<fastbc::kmeans::MiniBatchKMeans<FASTBC_V_TYPE, FASTBC_W_TYPE>>(
+					kmeansBatch, 0, kmeansInitialization);
+			}
+			else
+			{
+				kmeans = std::make_shared<fastbc::kmeans::HamerlyKMeans<FASTBC_V_TYPE, FASTBC_W_TYPE>>(
+					kmeansInitialization);
+			}
+
 			// Kmeans approximated pivot selector
 			pivotSelector = 
 				std::make_shared<fastbc::brandes::KMeansPivotSelector<FASTBC_V_TYPE, FASTBC_W_TYPE>>(
 					std::shared_ptr<fastbc::brandes::IPivotSelector<FASTBC_V_TYPE, FASTBC_W_TYPE>>(
 						new fastbc::brandes::VertexInfoPivotSelector<FASTBC_V_TYPE, FASTBC_W_TYPE>()),
-					std::shared_ptr<fastbc::kmeans::IKMeans<FASTBC_V_TYPE, FASTBC_W_TYPE>>(
-						new fastbc::kmeans::PlusPlusKMeans<FASTBC_V_TYPE, FASTBC_W_TYPE>()),
-					kFrac);
+					kmeans,
+					kFrac,
+					0,
+					kmeansIterations,
+					kmeansProjection);
 		}
 		else
 		{
@@ -251,8 +398,17 @@ int main(int argc, char **argv)
 		}
 
 		/* Single source Brandes */
-		std::shared_ptr<fastbc::brandes::DijkstraSSBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>> singleSourceBC =
-			std::make_shared<fastbc::brandes::DijkstraSSBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>>();
+		std::shared_ptr<fastbc::brandes::ISSBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>> singleSourceBC;
+		if (uniformWeights)
+		{
+			singleSourceBC =
+				std::make_shared<fastbc::brandes::BFSSSBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>>();
+		}
+		else
+		{
+			singleSourceBC =
+				std::make_shared<fastbc::brandes::DijkstraSSBrandesBC<FASTBC_V_TYPE, FASTBC_W_TYPE>>();
+		}
 
 		/* Clustered Brandes Betweenness centrality calculator */
 		brandesBC =